@@ -22,10 +22,35 @@
 #include "string.h"
 #include "quadmath.h"
 #include "time.h"
+#include "stdarg.h"
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <chrono>
+#include <algorithm>
+#include <new>
+#include "tsapredictor.h"
+
+// file-backed memory for MEMLIMIT, worker processes for SWEEP
+#if defined(__unix__) || defined(__APPLE__)
+#define _MMAPAVAILABLE
+#define _FORKAVAILABLE
+#include "stdlib.h"
+#include "unistd.h"
+#include "sys/mman.h"
+#include "sys/wait.h"
+#include "sys/resource.h"
+#endif
 
 typedef uint8_t BYTE;
 typedef uint32_t DDBYTE;
 typedef DDBYTE *PDDBYTE;
+// a tile row of 2 words read at once (little endian: pixel x
+// of the tile is bit x), may alias the DDBYTEs
+typedef uint64_t __attribute__((__may_alias__)) TILEROW;
+typedef TILEROW* PTILEROW;
 
 // chunk size dependend on operating system
 // win32 => 512 MB
@@ -49,6 +74,7 @@ const DDBYTE ALL32GRAY=0;
 const BYTE SQUARE_POTW=1;
 const DDBYTE DDBYTEMAX=0b11111111111111111111111111111111;
 const DDBYTE ALL32POTW=DDBYTEMAX;
+const TILEROW ALL64POTW=~(TILEROW)0;
 
 #ifdef _QUADMATH
 typedef __float128 NTYP;
@@ -69,46 +95,234 @@ const char NNTYPSTR[]="d";
 const NTYP ZEROEPSILON=1E-15;
 // the number 0 is
 const NTYP COEFFZEROLIMIT=1E-40;
+// a critical orbit returning this close (squared) after p steps
+// is refined by Newton to a cycle of period p
+const NTYP CYCLECANDIDATEQ=1E-8;
+// the critical orbits are iterated at most this many times MAXIT
+// as long as they are still contracting
+const int32_t MAXITFACTOR=16;
+// PROPAGATION=WORKLIST: cells and edges of a level at most this
+// many bytes (and within MEMLIMIT), else the level is swept
+const int64_t WORKLISTMAXBYTES=(int64_t)4 << 30;
+// SEARCH=PREDICT: level estimated from the multiplier is off by
+// about +-0.8 (offset fitted over random z2c..z5azc cycles), the
+// search starts this many levels below
+const double PREDICTOFFSET=2.8;
+const double PREDICTMARGIN=2.0;
+// smallest enclosement width of ENCW=AUTO
+const int32_t ENCWAUTOMIN=32;
+// METRICS: levels noted per cycle at most
+const int32_t MAXLEVELMETRICS=256;
 // maximal degree for class Polynom
 const int32_t MAXDEGREE=32;
 
 // array manager
 const int32_t MAXPTR=2048;
 
+// rows handed out at once to a worker thread
+const int32_t ROWCHUNK=16;
+
+// tiles of the sparse bitmap: 64 rows of 2 words = 64x64 pixels,
+// the hit test reads a tile row as one 64-bit TILEROW
+const int32_t TILESHIFTY=6;
+const int32_t TILESHIFTM=1;
+const int32_t TILEROWS=(1 << TILESHIFTY);
+const int32_t TILEMEMS=(1 << TILESHIFTM);
+const int32_t TILEWORDS=TILEROWS*TILEMEMS;
+// pixels per tile row, one TILEROW
+const int32_t TILESHIFTX=TILESHIFTM+SHIFTPERDDBYTE;
+const int32_t TILEPIXELS=(1 << TILESHIFTX);
+// largest tile grid indexed directly (16 MB)
+const int64_t TILEDENSEMAX=( (int64_t)1 << 22);
+
 enum { 
 	FUNC_Z2C=0,FUNC_Z2AZC=1,FUNC_Z3AZC=2,
 	FUNC_Z4AZC=3,FUNC_Z5AZC=4,FUNC_Z6AZC=5,
+	// z^N+A*z+c of degree _DEGREE, 7 <= N < MAXDEGREE
+	FUNC_ZNAZC=6,
 	
 	FUNCANZ
 };
 
 const char funcname[][32] = {
-	"Z2C","Z2AZC","Z3AZC","Z4AZC","Z5AZC","Z6AZC"
+	"Z2C","Z2AZC","Z3AZC","Z4AZC","Z5AZC","Z6AZC","ZNAZC"
+};
+
+// how POTW information is propagated in cm_local
+enum {
+	PROPAGATION_SWEEP=0,PROPAGATION_WORKLIST=1
+};
+
+// storage of the cell bitmap in cm_local
+enum {
+	BITMAP_ROWS=0,BITMAP_TILES=1
+};
+
+// order in which cm_local checks the levels
+enum {
+	SEARCH_LINEAR=0,SEARCH_GALLOP=1,SEARCH_PREDICT=2
+};
+
+// how ps_find_critical_points finds the zeros of f'
+enum {
+	CRITICAL_AUTO=0,CRITICAL_ABERTH=1,CRITICAL_SCAN=2
+};
+
+// METRICS: where the outcome of a level came from
+enum {
+	LEVELSOURCE_COMPUTED=0,LEVELSOURCE_CACHE=1,LEVELSOURCE_CHECKPOINT=2
+};
+
+const char levelsourcename[][12] = {
+	"computed","cache","checkpoint"
+};
+
+// result records of BATCH
+enum {
+	BATCHFORMAT_CSV=0,BATCHFORMAT_JSONL=1
+};
+
+// bounding-box kernel over several cells at once
+enum {
+	SIMD_OFF=0,SIMD_GENERIC=1,SIMD_AVX2=2,SIMD_AVX512=3,SIMD_AUTO=4
+};
+
+const char simdname[][16] = {
+	"off","generic","avx2","avx512"
+};
+
+// number type the levels are analyzed in
+enum {
+	PRECISION_D=0,PRECISION_LD=1,PRECISION_QD=2,PRECISION_AUTO=3,
+	// PRECISION=dy, per level one of the fixed-point widths
+	PRECISION_DY=4,PRECISION_DY128=5,PRECISION_DY192=6,PRECISION_DY256=7,
+	PRECISION_DD=8
+};
+
+const char precisionname[][8] = {
+	"d","ld","qd","auto","dy","dy128","dy192","dy256","dd"
+};
+
+// PRECISION=auto: highest level analyzed in double resp. long double
+// per function, above that __float128. From the recommendations in
+// the README, z2azc like z2c
+const int32_t precisionlimit[][2] = {
+	{24,24},{24,24},{17,20},{13,15},{0,0},{0,0},{0,0}
 };
 
 
 // structs
 
-struct PlaneRect {
-	NTYP x0,x1,y0,y1;
+template<class T>
+struct PlaneRectT {
+	typedef T SCALAR;
+	T x0,x1,y0,y1;
 };
 
+typedef PlaneRectT<NTYP> PlaneRect;
+
 struct ScreenRect {
 	int32_t x0,x1,y0,y1;
 };
 
+// a batch of cells in SoA layout: the bounding-box formulas are
+// evaluated with GCC vector types, lane-wise identical to the
+// scalar computation. One vector register per coordinate, the
+// width depends on the instruction set
+typedef double V2NTYP __attribute__((vector_size(2*sizeof(double))));
+typedef double V4NTYP __attribute__((vector_size(4*sizeof(double))));
+typedef double V8NTYP __attribute__((vector_size(8*sizeof(double))));
+
+template<class V>
+struct PlaneRectBatch {
+	typedef double SCALAR;
+	V x0,x1,y0,y1;
+};
+// vectors are only passed by reference or within inlined
+// code, the ABI note on returning them does not apply
+#pragma GCC diagnostic ignored "-Wpsabi"
+
+struct TextBuffer {
+	char* text;
+	int32_t len,allocated;
+	
+	TextBuffer();
+	virtual ~TextBuffer();
+	void clear(void);
+	void append(const char*,...);
+	void vappend(const char*,va_list);
+};
+
 struct ArrayDDByteManager {
 	DDBYTE* current;
 	int32_t allocatedIdx,freeFromIdx,allocatePerBlock;
 	PDDBYTE ptr[MAXPTR];
-	int32_t anzptr;
+	int8_t mapped[MAXPTR]; // block is a file mapping
+	int32_t anzptr; // blocks in use
+	int32_t anzallocated; // blocks owned, reused after ReleaseAll
+	int64_t bytesallocated; // of all blocks ever allocated
+	TextBuffer* out; // progress output, NULL=stdout
 	
 	ArrayDDByteManager ();
 	virtual ~ArrayDDByteManager ();
 	void FreeAll(void);
+	void ReleaseAll(void);
 	PDDBYTE getMemory(const int32_t);
 };
 
+// sparse cell bitmap for BITMAP=TILES: only tiles overlapping an
+// enclosement of a periodic point exist, all other pixels are POTW.
+// Tiles are found by their coordinates (mem >> TILESHIFTM,
+// y >> TILESHIFTY) in a table over the tile grid of the enclosement
+// if that is small enough, otherwise in an open-addressing hash table.
+// The tiles are numbered in Z-order of their coordinates (mortonOrder),
+// so tiles next to each other in the plane mostly are in memory too
+struct TiledBitmap {
+	int32_t anztiles,maxtiles;
+	int32_t *tilem,*tiley;
+	int8_t* tilewithgray;
+	PDDBYTE words; // TILEWORDS per tile, row by row
+	int8_t wordsmapped; // words is a file mapping
+	int64_t wordsallocated; // length of words, kept by clearTiles
+	int64_t bytesallocated; // of all words ever allocated
+	int32_t* dense; // tile number, -1 = not present
+	int32_t densetm0,densety0,denselenm,denseleny;
+	int32_t* hash; // tile number, -1 = empty
+	uint32_t hashmask;
+	
+	TiledBitmap();
+	virtual ~TiledBitmap();
+	void FreeAll(void);
+	void clearTiles(void);
+	void freeWords(void);
+	void setMaxTiles(const int64_t,const int32_t,const int32_t,const int32_t,const int32_t);
+	int32_t findTile(const int32_t,const int32_t);
+	int32_t addTile(const int32_t,const int32_t);
+	void mortonOrder(void);
+	void allocateWords(void);
+	PDDBYTE getWord(const int32_t,const int32_t);
+};
+
+// CACHE=file: outcome of every level analyzed, per cycle. Entries
+// are found by a 64-bit hash of their text (key, level, datatype)
+// in an open-addressing table, new ones are appended to the file
+struct ResultCache {
+	FILE* f;
+	uint64_t* hash; // 0 = empty
+	int8_t* black;
+	int64_t anz;
+	uint64_t hashmask;
+	std::mutex m;
+	
+	ResultCache();
+	virtual ~ResultCache();
+	void open(const char*);
+	void close(void);
+	int8_t lookup(const char*,const int32_t,const char*);
+	void store(const char*,const int32_t,const char*,const int8_t);
+	void insert(const uint64_t,const int8_t);
+};
+
 struct Complex {
 	NTYP re,im;
 	
@@ -145,6 +359,399 @@ struct PeriodicPoint {
 	int32_t y0,y1;
 };
 
+// CHECKPOINT/RESUME: outcome of the levels of a cycle analyzed so
+// far and the geometry of the level in progress, followed in the
+// file by its bitmap
+struct CheckpointHeader {
+	char magic[8];
+	char key[256]; // cyclecachekey
+	int8_t outcome[32]; // -1 not analyzed, 0 no black, 1 black
+	int8_t outcomeprec[32];
+	int32_t level,levelprec; // level in progress, 0 = none
+	int32_t tiled;
+	ScreenRect enclosementall;
+	int32_t mem0,lenx,leny; // rows of lenx words
+	int32_t anztiles;
+	int32_t encw; // ENCW=AUTO: enclosement width of the level in progress
+};
+
+// EXPORT=file: the bitmap of the level black emerges at. The header
+// is followed for every row y0..y1 of pixels by the number of runs
+// and the runs (int32) of its pixels x0..x1, alternately POTW and
+// GRAY, starting with POTW (that run may be 0). Pixel (x,y)
+// is the square COMPLETE0+[x,x+1]*w x COMPLETE0+[y,y+1]*w of the
+// level, w=(COMPLETE1-COMPLETE0)/2^level
+struct ExportHeader {
+	char magic[8];
+	char func[16]; // as in the result records
+	double cre,cim,are,aim;
+	double complete0,complete1;
+	int32_t level,levelprec;
+	int32_t cyclenumber,period;
+	int32_t encw;
+	ScreenRect enclosementall;
+	ScreenRect pixels; // written: enclosementall widened to whole words
+};
+
+// state of one cm_local analysis: cycles are analyzed
+// concurrently, so this must not be global
+struct CmTask {
+	int32_t threads;
+	TextBuffer* out; // progress output, NULL=stdout
+	// bitmap memory kept for the next cm_local call
+	// (BATCH), NULL = cm_local allocates and frees its own
+	ArrayDDByteManager* rows;
+	TiledBitmap* tiles;
+	// CHECKPOINT/RESUME of this cycle, set by cm_local
+	CheckpointHeader* ckpt;
+	char ckptfn[1100],resumefn[1100];
+	// EXPORT of this cycle: file, level written (0 = none)
+	char exportfn[1100];
+	int32_t exportlevel;
+	
+	CmTask();
+};
+
+// the pixel grid of the level being analyzed, in the number
+// type T of that level
+template<class T>
+struct CmGrid {
+	PlaneRectT<T> local;
+	T scaleRangePerPixel,scalePixelPerRange;
+	// MIXED: local, scale and error bound of the double bounding
+	// boxes, counter of the cells re-evaluated in T (METRICS)
+	int8_t mixed;
+	PlaneRectT<double> localD;
+	double scalePixelPerRangeD,errorD;
+	std::atomic<int64_t>* nexact;
+};
+
+// SWEEP: nre x nim equidistant values in [re0..re1]x[im0..im1],
+// nre=0: no grid
+struct SweepGrid {
+	double re0,re1,im0,im1;
+	int32_t nre,nim;
+};
+
+// a point of a SWEEP: index over all points, position in the
+// c grid and index in the A grid
+struct SweepPoint {
+	int64_t idx;
+	int32_t ix,iy,ia;
+};
+
+// PRECISION=dy: exact fixed-point numbers of L 64-bit limbs in two's
+// complement, F of the 64*L bits after the binary point. All values the
+// levels compute are dyadic (c and A in 2^-25, the complete square a
+// power of two, cell edges multiples of 2^-level), so products and sums
+// are exact as long as F covers the fraction bits and 64*L-F the integer
+// bits - levelprecision sizes L per level by setdyadic
+template<int L>
+struct Dyadic {
+	uint64_t v[L]; // v[0] lowest limb
+	static int32_t F;
+	
+	Dyadic() {}
+	explicit Dyadic(const int64_t a) {
+		for(int32_t i=0;i<L;i++) v[i]=(a < 0 ? ~(uint64_t)0 : 0);
+		v[0]=(uint64_t)a;
+		shiftleft(F);
+	}
+	explicit Dyadic(const int a) : Dyadic((int64_t)a) {}
+	// rounded down to a multiple of 2^-F
+	explicit Dyadic(const long double a) {
+		for(int32_t i=0;i<L;i++) v[i]=0;
+		if (a == 0) return;
+		int ex;
+		long double m=frexpl(fabsl(a),&ex);
+		v[0]=(uint64_t)ldexpl(m,64);
+		int32_t s=ex-64+F;
+		int8_t inexact=0;
+		if (s >= 0) shiftleft(s);
+		else {
+			inexact=((-s >= 64) || ( (v[0] << (64+s)) != 0));
+			v[0]=(-s >= 64 ? 0 : v[0] >> (-s));
+		}
+		if (a < 0) {
+			if (inexact) *this=*this+ulp();
+			*this=-*this;
+		}
+	}
+	explicit Dyadic(const double a) : Dyadic((long double)a) {}
+	explicit Dyadic(const __float128 a) {
+		// exactly split into two long doubles
+		long double hi=(long double)a;
+		*this=Dyadic(hi)+Dyadic((long double)(a-(__float128)hi));
+	}
+	
+	static Dyadic ulp(void) {
+		Dyadic r;
+		for(int32_t i=0;i<L;i++) r.v[i]=0;
+		r.v[0]=1;
+		return r;
+	}
+	
+	int8_t negative(void) const {
+		return (int64_t)v[L-1] < 0;
+	}
+	
+	void shiftleft(const int32_t s) {
+		const int32_t w=s >> 6,b=s & 63;
+		for(int32_t i=L-1;i>=0;i--) {
+			uint64_t hi=(i-w >= 0 ? v[i-w] : 0);
+			uint64_t lo=(i-w-1 >= 0 ? v[i-w-1] : 0);
+			v[i]=(b == 0 ? hi : (hi << b) | (lo >> (64-b)));
+		}
+	}
+	
+	explicit operator long double() const {
+		Dyadic m=(negative() ? -*this : *this);
+		long double r=0;
+		for(int32_t i=L-1;i>=0;i--) r += ldexpl((long double)m.v[i],64*i-F);
+		return (negative() ? -r : r);
+	}
+	explicit operator double() const {
+		return (double)(long double)*this;
+	}
+	explicit operator __float128() const {
+		Dyadic m=(negative() ? -*this : *this);
+		__float128 r=0;
+		for(int32_t i=L-1;i>=0;i--) r += ldexpq((__float128)m.v[i],64*i-F);
+		return (negative() ? -r : r);
+	}
+	// integer part, the value must be integral and fit
+	explicit operator int() const {
+		const int32_t w=F >> 6,b=F & 63;
+		if (w >= L) return 0;
+		uint64_t r=v[w] >> b;
+		if ( (b > 0) && (w+1 < L) ) r |= v[w+1] << (64-b);
+		return (int)(int64_t)r;
+	}
+	
+	Dyadic operator-() const {
+		Dyadic r;
+		uint64_t carry=1;
+		for(int32_t i=0;i<L;i++) {
+			r.v[i]=~v[i]+carry;
+			carry=(carry && (r.v[i] == 0));
+		}
+		return r;
+	}
+	Dyadic operator+(const Dyadic& b) const {
+		Dyadic r;
+		uint64_t carry=0;
+		for(int32_t i=0;i<L;i++) {
+			unsigned __int128 s=(unsigned __int128)v[i]+b.v[i]+carry;
+			r.v[i]=(uint64_t)s;
+			carry=(uint64_t)(s >> 64);
+		}
+		return r;
+	}
+	Dyadic operator-(const Dyadic& b) const {
+		Dyadic r;
+		uint64_t borrow=0;
+		for(int32_t i=0;i<L;i++) {
+			unsigned __int128 d=(unsigned __int128)v[i]-b.v[i]-borrow;
+			r.v[i]=(uint64_t)d;
+			borrow=(uint64_t)(d >> 64) & 1;
+		}
+		return r;
+	}
+	Dyadic& operator+=(const Dyadic& b) { *this=*this+b; return *this; }
+	Dyadic& operator-=(const Dyadic& b) { *this=*this-b; return *this; }
+	
+	// schoolbook product of the magnitudes, shifted back by F
+	Dyadic operator*(const Dyadic& b) const {
+		const int8_t neg=negative() ^ b.negative();
+		Dyadic x=(negative() ? -*this : *this);
+		Dyadic y=(b.negative() ? -b : b);
+		uint64_t p[2*L+1];
+		for(int32_t i=0;i<=2*L;i++) p[i]=0;
+		for(int32_t i=0;i<L;i++) {
+			uint64_t carry=0;
+			for(int32_t j=0;j<L;j++) {
+				unsigned __int128 t=(unsigned __int128)x.v[i]*y.v[j]+p[i+j]+carry;
+				p[i+j]=(uint64_t)t;
+				carry=(uint64_t)(t >> 64);
+			}
+			p[i+L]=carry;
+		}
+		const int32_t w=F >> 6,bit=F & 63;
+		Dyadic r;
+		for(int32_t i=0;i<L;i++) {
+			r.v[i]=(bit == 0 ? p[w+i] : (p[w+i] >> bit) | (p[w+i+1] << (64-bit)));
+		}
+		return (neg ? -r : r);
+	}
+	
+	bool operator<(const Dyadic& b) const {
+		if (v[L-1] != b.v[L-1]) return (int64_t)v[L-1] < (int64_t)b.v[L-1];
+		for(int32_t i=L-2;i>=0;i--) {
+			if (v[i] != b.v[i]) return v[i] < b.v[i];
+		}
+		return 0;
+	}
+	bool operator>(const Dyadic& b) const { return b < *this; }
+	bool operator<=(const Dyadic& b) const { return !(b < *this); }
+	bool operator>=(const Dyadic& b) const { return !(*this < b); }
+};
+
+template<int L> int32_t Dyadic<L>::F=64*L-35;
+
+// small integer factors (binomials, 2*, 5*, pixel coordinates)
+template<int L>
+inline Dyadic<L> operator*(const int64_t a,const Dyadic<L>& b) {
+	const int8_t neg=( (a < 0) != b.negative());
+	Dyadic<L> x=(b.negative() ? -b : b);
+	const uint64_t f=(a < 0 ? -(uint64_t)a : (uint64_t)a);
+	uint64_t carry=0;
+	for(int32_t i=0;i<L;i++) {
+		unsigned __int128 t=(unsigned __int128)x.v[i]*f+carry;
+		x.v[i]=(uint64_t)t;
+		carry=(uint64_t)(t >> 64);
+	}
+	return (neg ? -x : x);
+}
+
+template<int L>
+inline Dyadic<L> operator*(const int a,const Dyadic<L>& b) {
+	return (int64_t)a*b;
+}
+
+// only for the scales, powers of two
+template<int L>
+inline Dyadic<L> operator/(const Dyadic<L>& a,const double b) {
+	return Dyadic<L>((long double)a/b);
+}
+
+template<int L>
+inline Dyadic<L> operator/(const double a,const Dyadic<L>& b) {
+	return Dyadic<L>(a/(long double)b);
+}
+
+typedef Dyadic<2> Dyadic128;
+typedef Dyadic<3> Dyadic192;
+typedef Dyadic<4> Dyadic256;
+
+// PRECISION=dd: double-double, the unevaluated sum hi+lo with
+// |lo| <= ulp(hi)/2, about 106 bits. Products use the error-free
+// fma(a,b,-a*b) (a hardware instruction if compiled with FMA, e.g.
+// -march=native, otherwise exact in the math library), sums the
+// error-free two-sum. No branches but the comparisons
+struct DoubleDouble {
+	double hi,lo;
+	
+	DoubleDouble() {}
+	DoubleDouble(const double ahi,const double alo) : hi(ahi),lo(alo) {}
+	explicit DoubleDouble(const double a) : hi(a),lo(0) {}
+	explicit DoubleDouble(const int a) : hi(a),lo(0) {}
+	explicit DoubleDouble(const int64_t a) : hi((double)a),lo((double)(a-(int64_t)(double)a)) {}
+	explicit DoubleDouble(const long double a) : hi((double)a),lo((double)(a-(long double)(double)a)) {}
+	explicit DoubleDouble(const __float128 a) : hi((double)a),lo((double)(a-(__float128)(double)a)) {}
+	
+	explicit operator double() const { return hi; }
+	explicit operator long double() const { return (long double)hi+lo; }
+	explicit operator __float128() const { return (__float128)hi+lo; }
+	// integer part, the value must be integral and fit
+	explicit operator int() const { return (int)((int64_t)hi+(int64_t)lo); }
+	
+	// a+b if |a| >= |b|
+	static inline DoubleDouble quicktwosum(const double a,const double b) {
+		double s=a+b;
+		return DoubleDouble(s,b-(s-a));
+	}
+	static inline DoubleDouble twosum(const double a,const double b) {
+		double s=a+b;
+		double bb=s-a;
+		return DoubleDouble(s,(a-(s-bb))+(b-bb));
+	}
+	
+	DoubleDouble operator-() const {
+		return DoubleDouble(-hi,-lo);
+	}
+	DoubleDouble operator+(const DoubleDouble& b) const {
+		DoubleDouble s=twosum(hi,b.hi);
+		DoubleDouble t=twosum(lo,b.lo);
+		s=quicktwosum(s.hi,s.lo+t.hi);
+		return quicktwosum(s.hi,s.lo+t.lo);
+	}
+	DoubleDouble operator-(const DoubleDouble& b) const {
+		return *this+(-b);
+	}
+	DoubleDouble& operator+=(const DoubleDouble& b) { *this=*this+b; return *this; }
+	DoubleDouble& operator-=(const DoubleDouble& b) { *this=*this-b; return *this; }
+	DoubleDouble operator*(const DoubleDouble& b) const {
+		double p=hi*b.hi;
+		double e=fma(hi,b.hi,-p);
+		e += hi*b.lo+lo*b.hi;
+		return quicktwosum(p,e);
+	}
+	
+	bool operator<(const DoubleDouble& b) const { return (hi < b.hi) || ( (hi == b.hi) && (lo < b.lo) ); }
+	bool operator>(const DoubleDouble& b) const { return b < *this; }
+	bool operator<=(const DoubleDouble& b) const { return !(b < *this); }
+	bool operator>=(const DoubleDouble& b) const { return !(*this < b); }
+};
+
+// small integer factors (binomials, 2*, 5*, pixel coordinates)
+inline DoubleDouble operator*(const int64_t a,const DoubleDouble& b) {
+	const double f=(double)a;
+	double p=f*b.hi;
+	return DoubleDouble::quicktwosum(p,fma(f,b.hi,-p)+f*b.lo);
+}
+
+inline DoubleDouble operator*(const int a,const DoubleDouble& b) {
+	return (int64_t)a*b;
+}
+
+inline DoubleDouble operator/(const DoubleDouble& a,const double b) {
+	double q1=a.hi/b;
+	// remainder a-q1*b exactly up to its low part
+	double p=q1*b;
+	double r=( (a.hi-p)-fma(q1,b,-p) )+a.lo;
+	return DoubleDouble::quicktwosum(q1,r/b);
+}
+
+inline DoubleDouble operator/(const double a,const DoubleDouble& b) {
+	double q1=a/b.hi;
+	DoubleDouble r=DoubleDouble(a)-DoubleDouble(q1)*b;
+	return DoubleDouble::quicktwosum(q1,r.hi/b.hi);
+}
+
+// polynomial constants, complete square and bounding-box function
+// in the number type T a level is analyzed in. Set from the NTYP
+// globals (exactly, those are dyadic) by setnumcore
+template<class T>
+struct NumCore {
+	static T seedC0re,seedC1re,seedC0im,seedC1im;
+	static T FAKTORAre,FAKTORAim;
+	static T COMPLETE0,COMPLETE1;
+	static void (*getBoundingBoxfA)(PlaneRectT<T>&,PlaneRectT<T>&);
+};
+
+template<class T> T NumCore<T>::seedC0re;
+template<class T> T NumCore<T>::seedC1re;
+template<class T> T NumCore<T>::seedC0im;
+template<class T> T NumCore<T>::seedC1im;
+template<class T> T NumCore<T>::FAKTORAre;
+template<class T> T NumCore<T>::FAKTORAim;
+template<class T> T NumCore<T>::COMPLETE0;
+template<class T> T NumCore<T>::COMPLETE1;
+template<class T> void (*NumCore<T>::getBoundingBoxfA)(PlaneRectT<T>&,PlaneRectT<T>&) = NULL;
+
+// METRICS: counters of one level analyzed in cm_local
+struct LevelMetrics {
+	int32_t level,encw,prec,passes;
+	int8_t source,black;
+	int64_t cells; // gray cells evaluated
+	int64_t bbx; // bounding boxes computed, scalar or in batches
+	int64_t pixels; // pixels read by the hit test
+	int64_t footprint; // bytes of the bitmap
+	int64_t bytes; // bytes newly allocated for the bitmap
+	int64_t exact; // MIXED: bounding boxes re-evaluated in the level's type
+	double seconds;
+};
+
 struct Root {
 	Complex attractor;
 	PeriodicPoint* cycle;
@@ -153,10 +760,26 @@ struct Root {
 	int cyclelen;
 	int cyclenumber;
 	double multiplier;
+	int encw; // ENCW the level interiorfound was analyzed with
+	// CONTINUE: level of the cycle at the previous SWEEP point, 0 = none
+	int continuelevel;
+	// METRICS: levels analyzed, NULL = not counted
+	LevelMetrics* metrics;
+	int32_t anzmetrics;
+	double seconds;
 	
 	void clear(void);
 };
 
+// CONTINUE: what a SWEEP point leaves for the next one the process
+// computes, per critical point (in the order of zero)
+struct ContinuationCycle {
+	Complex attractor;
+	Complex pp; // a periodic point of its attracting cycle
+	int32_t period; // 0 = none
+	int32_t level; // black found at, 0 = none or not analyzed
+};
+
 
 // globals
 
@@ -168,71 +791,143 @@ Root zero[MAXZEROS];
 char COMPUTECOMMANDLINE[4096];
 int fctr=1;
 int _ENCLOSEMENTWIDTH=128;
+// ENCW=AUTO: per level the enclosements grow from ENCWAUTOMIN
+// up to _ENCLOSEMENTWIDTH
+int _ENCWAUTO=0;
+int _PROPAGATION=PROPAGATION_SWEEP;
+int THREADS=1;
+int _INCREMENTAL=0;
+// MIXED: bounding boxes of levels in a higher type first in double
+int _MIXED=0;
+// JOINT: the selected cycles analyzed together on one grid
+int _JOINT=0;
+int _SEARCH=SEARCH_LINEAR;
+int _CRITICAL=CRITICAL_AUTO;
+int _BITMAP=BITMAP_ROWS;
+// MEMLIMIT: bytes of bitmap blocks kept in RAM by all cycles
+// together, further blocks are mapped to files. 0 = no limit
+int64_t _MEMLIMIT=0;
+std::atomic<int64_t> blocksinram(0);
 int nbr_of_cp;
 int PERIODICLEN0=-1,PERIODICLEN1=-1;
-PlaneRect local;
-void (*getBoundingBoxfA)(PlaneRect&,PlaneRect&) = NULL;
+int _SIMD=SIMD_AUTO;
+DDBYTE (*getScreenRectfA_word)(CmGrid<double>&,PlaneRectT<double>&,const int32_t,const DDBYTE,ScreenRect*) = NULL;
+int32_t wordkernellanes=0; // cells per batch of getScreenRectfA_word
+int _PRECISION=PRECISION_D;
+// BATCH: parameter file, result file (empty = stdout)
+char _BATCHFILE[1024]="";
+char _BATCHOUT[1024]="";
+int _BATCHFORMAT=BATCHFORMAT_CSV;
+char _CACHEFILE[1024]="";
+// CHECKPOINT: file name base and interval, RESUME: file name base
+char _CHECKPOINTFILE[1024]="";
+int32_t _CHECKPOINTSECONDS=600;
+char _RESUMEFILE[1024]="";
+ResultCache rcache;
+// METRICS: file the counters are appended to
+char _METRICSFILE[1024]="";
+// EXPORT: bitmaps of the levels found to file.c<cycle number>
+char _EXPORTFILE[1024]="";
+FILE* metricsfile=NULL;
+// SWEEP: grids over c and A, SHARD=i/n
+SweepGrid _SWEEPC={0,0,0,0,0,0};
+SweepGrid _SWEEPA={0,0,0,0,0,0};
+int32_t _SHARD=0,_SHARDS=1;
+// CONTINUE=margin: SWEEP points start from the critical points, cycles
+// and levels of the previous point of the process, -1 = off
+int32_t _CONTINUE=-1;
+ContinuationCycle contcycle[MAXZEROS];
+int32_t anzcont=0;
+// BENCH=n: repetitions of the benchmark corpus, 0 = no benchmark
+int32_t _BENCH=0;
+// BENCH: checkpoints written, a forked run ends before writing
+// the next one after benchpreempt (0 = never)
+int32_t benchckptwritten=0,benchpreempt=0;
 Polynom fkt;
 int _FUNC;
+int32_t _DEGREE=0;
 NTYP seedC0re,seedC1re,seedC0im,seedC1im; 
 NTYP FAKTORAre,FAKTORAim;
-NTYP scaleRangePerPixel,scalePixelPerRange;
 NTYP COMPLETE0,COMPLETE1;
 Complex cplxA,cplxC;
 
 // forward declarations
 
-inline int32_t scrcoord_as_lowerleft(const NTYP);
-inline NTYP minimumD(const NTYP,const NTYP);
-inline NTYP maximumD(const NTYP,const NTYP);
-inline NTYP minimumD(const NTYP,const NTYP,const NTYP,const NTYP);
-inline NTYP maximumD(const NTYP,const NTYP,const NTYP,const NTYP);
+template<class T> inline int32_t scrcoord_as_lowerleft(const T,const T);
+template<class T> inline T minimumD(const T,const T);
+template<class T> inline T maximumD(const T,const T);
+template<class T> inline T minimumD(const T,const T,const T,const T);
+template<class T> inline T maximumD(const T,const T,const T,const T);
+PDDBYTE getMappedBlock(const int64_t);
+void recordfuncname(char*);
 
 
-#define LOGMSG(TT) \
-{\
-	fprintf(flog,TT); fflush(flog);\
-	printf(TT);\
-}
+// messages go to the log and stdout. Within a call of the library
+// interface (tsa_...) to neither (unless the program itself makes
+// the call), the last one is kept as the error message of the call
+int8_t librarycall=0,libraryconsole=0;
+char lastlogmsg[512]="";
+std::mutex lastlogmutex;
 
-#define LOGMSG2(TT,AA) \
-{\
-	fprintf(flog,TT,AA); fflush(flog);\
-	printf(TT,AA);\
+void logmsg(const char* fmt,...) {
+	va_list args;
+	if (librarycall > 0) {
+		{
+			// worker threads may fail at the same time
+			std::lock_guard<std::mutex> lock(lastlogmutex);
+			va_start(args,fmt);
+			vsnprintf(lastlogmsg,sizeof(lastlogmsg),fmt,args);
+			va_end(args);
+		}
+		if (libraryconsole <= 0) return;
+	}
+	if (flog) {
+		va_start(args,fmt);
+		vfprintf(flog,fmt,args);
+		va_end(args);
+		fflush(flog);
+	}
+	va_start(args,fmt);
+	vprintf(fmt,args);
+	va_end(args);
 }
 
-#define LOGMSG3(TT,AA,BB) \
-{\
-	fprintf(flog,TT,AA,BB); fflush(flog);\
-	printf(TT,AA,BB);\
-}
+#define LOGMSG(TT) { logmsg(TT); }
+#define LOGMSG2(TT,AA) { logmsg(TT,AA); }
+#define LOGMSG3(TT,AA,BB) { logmsg(TT,AA,BB); }
+#define LOGMSG4(TT,AA,BB,CC) { logmsg(TT,AA,BB,CC); }
+#define LOGMSG5(TT,AA,BB,CC,DD) { logmsg(TT,AA,BB,CC,DD); }
 
-#define LOGMSG4(TT,AA,BB,CC) \
-{\
-	fprintf(flog,TT,AA,BB,CC); fflush(flog);\
-	printf(TT,AA,BB,CC);\
-}
+// an error ends the program, within a call of the library
+// interface the call instead returns TSA_ERR_FAILED (also when
+// the error occurs in a worker thread)
+struct TsaFailure {};
 
-#define LOGMSG5(TT,AA,BB,CC,DD) \
-{\
-	fprintf(flog,TT,AA,BB,CC,DD); fflush(flog);\
-	printf(TT,AA,BB,CC,DD);\
+[[noreturn]] void fail(void) {
+	if (librarycall > 0) throw TsaFailure();
+	exit(99);
 }
 
-#define SQUARE_LIES_ENTIRELY_IN_LOCAL(BBX) \
+// bitmap words are shared between worker threads. Bits only
+// ever change from GRAY to POTW, so relaxed atomics suffice
+#define ATOMIC_LOAD32(PTR) __atomic_load_n(PTR,__ATOMIC_RELAXED)
+#define ATOMIC_OR32(PTR,FF32) __atomic_fetch_or(PTR,FF32,__ATOMIC_RELAXED)
+#define ATOMIC_LOAD64(PTR) __atomic_load_n(PTR,__ATOMIC_RELAXED)
+
+#define SQUARE_LIES_ENTIRELY_IN_LOCAL(BBX,LOCAL) \
 	(\
-		(local.x0 <= BBX.x0) &&\
-		(BBX.x1 <= local.x1) &&\
-		(local.y0 <= BBX.y0) &&\
-		(BBX.y1 <= local.y1)\
+		(LOCAL.x0 <= BBX.x0) &&\
+		(BBX.x1 <= LOCAL.x1) &&\
+		(LOCAL.y0 <= BBX.y0) &&\
+		(BBX.y1 <= LOCAL.y1)\
 	)
 
-#define SQUARE_LIES_ENTIRELY_IN_COMPLETE(BBX) \
+#define SQUARE_LIES_ENTIRELY_IN_COMPLETE(BBX,C0,C1) \
 	(\
-		(COMPLETE0 <= BBX.x0) &&\
-		(BBX.x1 <= COMPLETE1) &&\
-		(COMPLETE0 <= BBX.y0) &&\
-		(BBX.y1 <= COMPLETE1)\
+		(C0 <= BBX.x0) &&\
+		(BBX.x1 <= C1) &&\
+		(C0 <= BBX.y0) &&\
+		(BBX.y1 <= C1)\
 	)
 
 
@@ -240,167 +935,717 @@ inline NTYP maximumD(const NTYP,const NTYP,const NTYP,const NTYP);
 
 // functions
 
-inline int32_t scrcoord_as_lowerleft(const NTYP a) {
+inline double floorT(const double a) {
+	return floor(a);
+}
+
+inline long double floorT(const long double a) {
+	return floorl(a);
+}
+
+inline __float128 floorT(const __float128 a) {
+	return floorq(a);
+}
+
+// two's complement: clearing the fraction bits rounds down
+template<int L>
+inline Dyadic<L> floorT(const Dyadic<L>& a) {
+	Dyadic<L> r=a;
+	for(int32_t i=0;i<L;i++) {
+		if (64*(i+1) <= Dyadic<L>::F) r.v[i]=0;
+		else if (64*i < Dyadic<L>::F) r.v[i] &= ~(uint64_t)0 << (Dyadic<L>::F-64*i);
+	}
+	return r;
+}
+
+// hi non-integral: hi+lo does not reach the next integer below
+inline DoubleDouble floorT(const DoubleDouble& a) {
+	double fh=floor(a.hi);
+	if (fh != a.hi) return DoubleDouble(fh,0);
+	return DoubleDouble::quicktwosum(fh,floor(a.lo));
+}
+
+template<class T>
+inline int32_t scrcoord_as_lowerleft(const T a,const T scalePixelPerRange) {
 	// calculating the screen coordinte of the pixel that contains the coordinate
 	// if the coordinate lies on an edge/corner (and belongs to more than one pixel)
 	// the pixel where it lies on the left,bottom edge/corner is returned
-	#ifdef _QUADMATH
-	return (int)floorq( (a - COMPLETE0) * scalePixelPerRange );
-	#else
-	return (int)floor( (a - COMPLETE0) * scalePixelPerRange );
-	#endif
+	return (int)floorT( (a - NumCore<T>::COMPLETE0) * scalePixelPerRange );
 }
 
-inline NTYP maximumD(const NTYP a,const NTYP b,const NTYP c,const NTYP d) {
-	NTYP m=a;
+template<class T>
+inline T maximumD(const T a,const T b,const T c,const T d) {
+	T m=a;
 	if (b > m) m=b;
 	if (c > m) m=c;
 	if (d > m) m=d;
 	return m;
 }
 
-inline NTYP minimumD(const NTYP a,const NTYP b,const NTYP c,const NTYP d) {
-	NTYP m=a;
+template<class T>
+inline T minimumD(const T a,const T b,const T c,const T d) {
+	T m=a;
 	if (b < m) m=b;
 	if (c < m) m=c;
 	if (d < m) m=d;
 	return m;
 }
 
-inline NTYP minimumD(const NTYP a,const NTYP b) {
+template<class T>
+inline T minimumD(const T a,const T b) {
 	if (a < b) return a;
 	return b;
 }
 
-inline NTYP maximumD(const NTYP a,const NTYP b) {
+template<class T>
+inline T maximumD(const T a,const T b) {
 	if (a > b) return a;
 	return b;
 }
 
-// z^2+c
-void getBoundingBoxfA_z2c(PlaneRect& A,PlaneRect& fA) {
-	fA.x0=minimumD(A.x0*A.x0,A.x1*A.x1)-maximumD(A.y0*A.y0,A.y1*A.y1)+seedC0re;
-	fA.x1=maximumD(A.x0*A.x0,A.x1*A.x1)-minimumD(A.y0*A.y0,A.y1*A.y1)+seedC1re;
-	fA.y0=2*minimumD(A.x0*A.y0,A.x0*A.y1,A.x1*A.y0,A.x1*A.y1)+seedC0im;
-	fA.y1=2*maximumD(A.x0*A.y0,A.x0*A.y1,A.x1*A.y0,A.x1*A.y1)+seedC1im;
+// branchless lane-wise versions, same comparisons as above
+#define VECTOR_MINMAX(V) \
+inline V minimumD(const V& a,const V& b) {\
+	return (a < b) ? a : b;\
+}\
+\
+inline V maximumD(const V& a,const V& b) {\
+	return (a > b) ? a : b;\
+}\
+\
+inline V maximumD(const V& a,const V& b,const V& c,const V& d) {\
+	V m=a;\
+	m=(b > m) ? b : m;\
+	m=(c > m) ? c : m;\
+	m=(d > m) ? d : m;\
+	return m;\
+}\
+\
+inline V minimumD(const V& a,const V& b,const V& c,const V& d) {\
+	V m=a;\
+	m=(b < m) ? b : m;\
+	m=(c < m) ? c : m;\
+	m=(d < m) ? d : m;\
+	return m;\
 }
 
-// z^2+A*z+c
-void getBoundingBoxfA_z2azc(PlaneRect& A,PlaneRect& fA) {
-	fA.x0=seedC0re+minimumD(FAKTORAre*A.x0,FAKTORAre*A.x1)+minimumD(A.x0*A.x0,A.x1*A.x1)-maximumD(FAKTORAim*A.y0,FAKTORAim*A.y1)-maximumD(A.y0*A.y0,A.y1*A.y1);
-	fA.x1=seedC1re+maximumD(FAKTORAre*A.x0,FAKTORAre*A.x1)+maximumD(A.x0*A.x0,A.x1*A.x1)-minimumD(FAKTORAim*A.y0,FAKTORAim*A.y1)-minimumD(A.y0*A.y0,A.y1*A.y1);
-	fA.y0=seedC0im+minimumD(FAKTORAim*A.x0,FAKTORAim*A.x1)+minimumD(FAKTORAre*A.y0,FAKTORAre*A.y1)+2*minimumD(A.x0*A.y0,A.x0*A.y1,A.x1*A.y0,A.x1*A.y1);
-	fA.y1=seedC1im+maximumD(FAKTORAim*A.x0,FAKTORAim*A.x1)+maximumD(FAKTORAre*A.y0,FAKTORAre*A.y1)+2*maximumD(A.x0*A.y0,A.x0*A.y1,A.x1*A.y0,A.x1*A.y1);
-}
+VECTOR_MINMAX(V2NTYP)
+VECTOR_MINMAX(V4NTYP)
+VECTOR_MINMAX(V8NTYP)
 
-// z^3+A*z+c
-void getBoundingBoxfA_z3azc(PlaneRect& A,PlaneRect& fA) {
-	fA.x0=minimumD(FAKTORAre*A.x0,FAKTORAre*A.x1)-maximumD(FAKTORAim*A.y0,FAKTORAim*A.y1)+A.x0*A.x0*A.x0-(3*maximumD(A.x0*minimumD(A.y0*A.y0,A.y1*A.y1),A.x0*maximumD(A.y0*A.y0,A.y1*A.y1),A.x1*minimumD(A.y0*A.y0,A.y1*A.y1),A.x1*maximumD(A.y0*A.y0,A.y1*A.y1)))+seedC0re;
-	fA.x1=maximumD(FAKTORAre*A.x0,FAKTORAre*A.x1)-minimumD(FAKTORAim*A.y0,FAKTORAim*A.y1)+A.x1*A.x1*A.x1-(3*minimumD(A.x0*minimumD(A.y0*A.y0,A.y1*A.y1),A.x0*maximumD(A.y0*A.y0,A.y1*A.y1),A.x1*minimumD(A.y0*A.y0,A.y1*A.y1),A.x1*maximumD(A.y0*A.y0,A.y1*A.y1)))+seedC1re;
-	fA.y0=minimumD(FAKTORAre*A.y0,FAKTORAre*A.y1)+minimumD(FAKTORAim*A.x0,FAKTORAim*A.x1)+3*minimumD(minimumD(A.x0*A.x0,A.x1*A.x1)*A.y0,minimumD(A.x0*A.x0,A.x1*A.x1)*A.y1,maximumD(A.x0*A.x0,A.x1*A.x1)*A.y0,maximumD(A.x0*A.x0,A.x1*A.x1)*A.y1)-(A.y1*A.y1*A.y1)+seedC0im;
-	fA.y1=maximumD(FAKTORAre*A.y0,FAKTORAre*A.y1)+maximumD(FAKTORAim*A.x0,FAKTORAim*A.x1)+3*maximumD(minimumD(A.x0*A.x0,A.x1*A.x1)*A.y0,minimumD(A.x0*A.x0,A.x1*A.x1)*A.y1,maximumD(A.x0*A.x0,A.x1*A.x1)*A.y0,maximumD(A.x0*A.x0,A.x1*A.x1)*A.y1)-(A.y0*A.y0*A.y0)+seedC1im;
-}
+// the bounding-box formulas are templates over the rectangle
+// type: PlaneRectT for single cells, PlaneRectBatch for vectors
+// of cells. Constants come from NumCore of the scalar type
 
-// z^4+A*z+c
-void getBoundingBoxfA_z4azc(PlaneRect& A,PlaneRect& fA) {
-	fA.x0=minimumD(FAKTORAre*A.x0,FAKTORAre*A.x1,FAKTORAre*A.x0,FAKTORAre*A.x1)-maximumD(FAKTORAim*A.y0,FAKTORAim*A.y1,FAKTORAim*A.y0,FAKTORAim*A.y1)+minimumD(A.x0*A.x0*A.x0*A.x0,A.x1*A.x1*A.x1*A.x1)-(6*maximumD(minimumD(A.x0*A.x0,A.x1*A.x1)*minimumD(A.y0*A.y0,A.y1*A.y1),minimumD(A.x0*A.x0,A.x1*A.x1)*maximumD(A.y0*A.y0,A.y1*A.y1),maximumD(A.x0*A.x0,A.x1*A.x1)*minimumD(A.y0*A.y0,A.y1*A.y1),maximumD(A.x0*A.x0,A.x1*A.x1)*maximumD(A.y0*A.y0,A.y1*A.y1)))+minimumD(A.y0*A.y0*A.y0*A.y0,A.y1*A.y1*A.y1*A.y1)+seedC0re;
-	fA.x1=maximumD(FAKTORAre*A.x0,FAKTORAre*A.x1,FAKTORAre*A.x0,FAKTORAre*A.x1)-minimumD(FAKTORAim*A.y0,FAKTORAim*A.y1,FAKTORAim*A.y0,FAKTORAim*A.y1)+maximumD(A.x0*A.x0*A.x0*A.x0,A.x1*A.x1*A.x1*A.x1)-(6*minimumD(minimumD(A.x0*A.x0,A.x1*A.x1)*minimumD(A.y0*A.y0,A.y1*A.y1),minimumD(A.x0*A.x0,A.x1*A.x1)*maximumD(A.y0*A.y0,A.y1*A.y1),maximumD(A.x0*A.x0,A.x1*A.x1)*minimumD(A.y0*A.y0,A.y1*A.y1),maximumD(A.x0*A.x0,A.x1*A.x1)*maximumD(A.y0*A.y0,A.y1*A.y1)))+maximumD(A.y0*A.y0*A.y0*A.y0,A.y1*A.y1*A.y1*A.y1)+seedC1re;
-	fA.y0=minimumD(FAKTORAre*A.y0,FAKTORAre*A.y1,FAKTORAre*A.y0,FAKTORAre*A.y1)+minimumD(FAKTORAim*A.x0,FAKTORAim*A.x1,FAKTORAim*A.x0,FAKTORAim*A.x1)+4*minimumD((A.x0*A.x0*A.x0)*A.y0,(A.x0*A.x0*A.x0)*A.y1,(A.x1*A.x1*A.x1)*A.y0,(A.x1*A.x1*A.x1)*A.y1)-(4*maximumD(A.x0*(A.y0*A.y0*A.y0),A.x0*(A.y1*A.y1*A.y1),A.x1*(A.y0*A.y0*A.y0),A.x1*(A.y1*A.y1*A.y1)))+seedC0im;
-	fA.y1=maximumD(FAKTORAre*A.y0,FAKTORAre*A.y1,FAKTORAre*A.y0,FAKTORAre*A.y1)+maximumD(FAKTORAim*A.x0,FAKTORAim*A.x1,FAKTORAim*A.x0,FAKTORAim*A.x1)+4*maximumD((A.x0*A.x0*A.x0)*A.y0,(A.x0*A.x0*A.x0)*A.y1,(A.x1*A.x1*A.x1)*A.y0,(A.x1*A.x1*A.x1)*A.y1)-(4*minimumD(A.x0*(A.y0*A.y0*A.y0),A.x0*(A.y1*A.y1*A.y1),A.x1*(A.y0*A.y0*A.y0),A.x1*(A.y1*A.y1*A.y1)))+seedC1im;
+// z^2+c
+template<class RECT>
+inline void bbxfA_z2c(RECT& A,RECT& fA) {
+	typedef NumCore<typename RECT::SCALAR> NC;
+	fA.x0=minimumD(A.x0*A.x0,A.x1*A.x1)-maximumD(A.y0*A.y0,A.y1*A.y1)+NC::seedC0re;
+	fA.x1=maximumD(A.x0*A.x0,A.x1*A.x1)-minimumD(A.y0*A.y0,A.y1*A.y1)+NC::seedC1re;
+	fA.y0=2*minimumD(A.x0*A.y0,A.x0*A.y1,A.x1*A.y0,A.x1*A.y1)+NC::seedC0im;
+	fA.y1=2*maximumD(A.x0*A.y0,A.x0*A.y1,A.x1*A.y0,A.x1*A.y1)+NC::seedC1im;
 }
 
-// z^5+A*z+c
-void getBoundingBoxfA_z5azc(PlaneRect& A,PlaneRect& fA) {
-	fA.x0=minimumD(FAKTORAre*A.x0,FAKTORAre*A.x1,FAKTORAre*A.x0,FAKTORAre*A.x1)-maximumD(FAKTORAim*A.y0,FAKTORAim*A.y1,FAKTORAim*A.y0,FAKTORAim*A.y1)+A.x0*A.x0*A.x0*A.x0*A.x0-(2*(5*maximumD((A.x0*A.x0*A.x0)*minimumD(A.y0*A.y0,A.y1*A.y1),(A.x0*A.x0*A.x0)*maximumD(A.y0*A.y0,A.y1*A.y1),(A.x1*A.x1*A.x1)*minimumD(A.y0*A.y0,A.y1*A.y1),(A.x1*A.x1*A.x1)*maximumD(A.y0*A.y0,A.y1*A.y1))))+5*minimumD(A.x0*minimumD(A.y0*A.y0*A.y0*A.y0,A.y1*A.y1*A.y1*A.y1),A.x0*maximumD(A.y0*A.y0*A.y0*A.y0,A.y1*A.y1*A.y1*A.y1),A.x1*minimumD(A.y0*A.y0*A.y0*A.y0,A.y1*A.y1*A.y1*A.y1),A.x1*maximumD(A.y0*A.y0*A.y0*A.y0,A.y1*A.y1*A.y1*A.y1))+seedC0re;
-	fA.x1=maximumD(FAKTORAre*A.x0,FAKTORAre*A.x1,FAKTORAre*A.x0,FAKTORAre*A.x1)-minimumD(FAKTORAim*A.y0,FAKTORAim*A.y1,FAKTORAim*A.y0,FAKTORAim*A.y1)+A.x1*A.x1*A.x1*A.x1*A.x1-(2*(5*minimumD((A.x0*A.x0*A.x0)*minimumD(A.y0*A.y0,A.y1*A.y1),(A.x0*A.x0*A.x0)*maximumD(A.y0*A.y0,A.y1*A.y1),(A.x1*A.x1*A.x1)*minimumD(A.y0*A.y0,A.y1*A.y1),(A.x1*A.x1*A.x1)*maximumD(A.y0*A.y0,A.y1*A.y1))))+5*maximumD(A.x0*minimumD(A.y0*A.y0*A.y0*A.y0,A.y1*A.y1*A.y1*A.y1),A.x0*maximumD(A.y0*A.y0*A.y0*A.y0,A.y1*A.y1*A.y1*A.y1),A.x1*minimumD(A.y0*A.y0*A.y0*A.y0,A.y1*A.y1*A.y1*A.y1),A.x1*maximumD(A.y0*A.y0*A.y0*A.y0,A.y1*A.y1*A.y1*A.y1))+seedC1re;
-	fA.y0=minimumD(FAKTORAre*A.y0,FAKTORAre*A.y1,FAKTORAre*A.y0,FAKTORAre*A.y1)+minimumD(FAKTORAim*A.x0,FAKTORAim*A.x1,FAKTORAim*A.x0,FAKTORAim*A.x1)+5*minimumD(minimumD(A.x0*A.x0*A.x0*A.x0,A.x1*A.x1*A.x1*A.x1)*A.y0,minimumD(A.x0*A.x0*A.x0*A.x0,A.x1*A.x1*A.x1*A.x1)*A.y1,maximumD(A.x0*A.x0*A.x0*A.x0,A.x1*A.x1*A.x1*A.x1)*A.y0,maximumD(A.x0*A.x0*A.x0*A.x0,A.x1*A.x1*A.x1*A.x1)*A.y1)-(2*(5*maximumD(minimumD(A.x0*A.x0,A.x1*A.x1)*(A.y0*A.y0*A.y0),minimumD(A.x0*A.x0,A.x1*A.x1)*(A.y1*A.y1*A.y1),maximumD(A.x0*A.x0,A.x1*A.x1)*(A.y0*A.y0*A.y0),maximumD(A.x0*A.x0,A.x1*A.x1)*(A.y1*A.y1*A.y1))))+A.y0*A.y0*A.y0*A.y0*A.y0+seedC0im;
-	fA.y1=maximumD(FAKTORAre*A.y0,FAKTORAre*A.y1,FAKTORAre*A.y0,FAKTORAre*A.y1)+maximumD(FAKTORAim*A.x0,FAKTORAim*A.x1,FAKTORAim*A.x0,FAKTORAim*A.x1)+5*maximumD(minimumD(A.x0*A.x0*A.x0*A.x0,A.x1*A.x1*A.x1*A.x1)*A.y0,minimumD(A.x0*A.x0*A.x0*A.x0,A.x1*A.x1*A.x1*A.x1)*A.y1,maximumD(A.x0*A.x0*A.x0*A.x0,A.x1*A.x1*A.x1*A.x1)*A.y0,maximumD(A.x0*A.x0*A.x0*A.x0,A.x1*A.x1*A.x1*A.x1)*A.y1)-(2*(5*minimumD(minimumD(A.x0*A.x0,A.x1*A.x1)*(A.y0*A.y0*A.y0),minimumD(A.x0*A.x0,A.x1*A.x1)*(A.y1*A.y1*A.y1),maximumD(A.x0*A.x0,A.x1*A.x1)*(A.y0*A.y0*A.y0),maximumD(A.x0*A.x0,A.x1*A.x1)*(A.y1*A.y1*A.y1))))+A.y1*A.y1*A.y1*A.y1*A.y1+seedC1im;
+// z^2+A*z+c
+template<class RECT>
+inline void bbxfA_z2azc(RECT& A,RECT& fA) {
+	typedef NumCore<typename RECT::SCALAR> NC;
+	fA.x0=NC::seedC0re+minimumD(NC::FAKTORAre*A.x0,NC::FAKTORAre*A.x1)+minimumD(A.x0*A.x0,A.x1*A.x1)-maximumD(NC::FAKTORAim*A.y0,NC::FAKTORAim*A.y1)-maximumD(A.y0*A.y0,A.y1*A.y1);
+	fA.x1=NC::seedC1re+maximumD(NC::FAKTORAre*A.x0,NC::FAKTORAre*A.x1)+maximumD(A.x0*A.x0,A.x1*A.x1)-minimumD(NC::FAKTORAim*A.y0,NC::FAKTORAim*A.y1)-minimumD(A.y0*A.y0,A.y1*A.y1);
+	fA.y0=NC::seedC0im+minimumD(NC::FAKTORAim*A.x0,NC::FAKTORAim*A.x1)+minimumD(NC::FAKTORAre*A.y0,NC::FAKTORAre*A.y1)+2*minimumD(A.x0*A.y0,A.x0*A.y1,A.x1*A.y0,A.x1*A.y1);
+	fA.y1=NC::seedC1im+maximumD(NC::FAKTORAim*A.x0,NC::FAKTORAim*A.x1)+maximumD(NC::FAKTORAre*A.y0,NC::FAKTORAre*A.y1)+2*maximumD(A.x0*A.y0,A.x0*A.y1,A.x1*A.y0,A.x1*A.y1);
 }
 
 // z^5+c*z+A
 // c kann IA sein, A ist fix
-void getBoundingBoxfA_z5cza(PlaneRect& A,PlaneRect& fA) {
-	fA.x0=minimumD(seedC0re*A.x0,seedC0re*A.x1,seedC1re*A.x0,seedC1re*A.x1)-maximumD(seedC0im*A.y0,seedC0im*A.y1,seedC1im*A.y0,seedC1im*A.y1)+A.x0*A.x0*A.x0*A.x0*A.x0-(2*(5*maximumD((A.x0*A.x0*A.x0)*minimumD(A.y0*A.y0,A.y1*A.y1),(A.x0*A.x0*A.x0)*maximumD(A.y0*A.y0,A.y1*A.y1),(A.x1*A.x1*A.x1)*minimumD(A.y0*A.y0,A.y1*A.y1),(A.x1*A.x1*A.x1)*maximumD(A.y0*A.y0,A.y1*A.y1))))+5*minimumD(A.x0*minimumD(A.y0*A.y0*A.y0*A.y0,A.y1*A.y1*A.y1*A.y1),A.x0*maximumD(A.y0*A.y0*A.y0*A.y0,A.y1*A.y1*A.y1*A.y1),A.x1*minimumD(A.y0*A.y0*A.y0*A.y0,A.y1*A.y1*A.y1*A.y1),A.x1*maximumD(A.y0*A.y0*A.y0*A.y0,A.y1*A.y1*A.y1*A.y1))+FAKTORAre;
-	fA.x1=maximumD(seedC0re*A.x0,seedC0re*A.x1,seedC1re*A.x0,seedC1re*A.x1)-minimumD(seedC0im*A.y0,seedC0im*A.y1,seedC1im*A.y0,seedC1im*A.y1)+A.x1*A.x1*A.x1*A.x1*A.x1-(2*(5*minimumD((A.x0*A.x0*A.x0)*minimumD(A.y0*A.y0,A.y1*A.y1),(A.x0*A.x0*A.x0)*maximumD(A.y0*A.y0,A.y1*A.y1),(A.x1*A.x1*A.x1)*minimumD(A.y0*A.y0,A.y1*A.y1),(A.x1*A.x1*A.x1)*maximumD(A.y0*A.y0,A.y1*A.y1))))+5*maximumD(A.x0*minimumD(A.y0*A.y0*A.y0*A.y0,A.y1*A.y1*A.y1*A.y1),A.x0*maximumD(A.y0*A.y0*A.y0*A.y0,A.y1*A.y1*A.y1*A.y1),A.x1*minimumD(A.y0*A.y0*A.y0*A.y0,A.y1*A.y1*A.y1*A.y1),A.x1*maximumD(A.y0*A.y0*A.y0*A.y0,A.y1*A.y1*A.y1*A.y1))+FAKTORAre;
-	fA.y0=minimumD(seedC0re*A.y0,seedC0re*A.y1,seedC1re*A.y0,seedC1re*A.y1)+minimumD(seedC0im*A.x0,seedC0im*A.x1,seedC1im*A.x0,seedC1im*A.x1)+5*minimumD(minimumD(A.x0*A.x0*A.x0*A.x0,A.x1*A.x1*A.x1*A.x1)*A.y0,minimumD(A.x0*A.x0*A.x0*A.x0,A.x1*A.x1*A.x1*A.x1)*A.y1,maximumD(A.x0*A.x0*A.x0*A.x0,A.x1*A.x1*A.x1*A.x1)*A.y0,maximumD(A.x0*A.x0*A.x0*A.x0,A.x1*A.x1*A.x1*A.x1)*A.y1)-(2*(5*maximumD(minimumD(A.x0*A.x0,A.x1*A.x1)*(A.y0*A.y0*A.y0),minimumD(A.x0*A.x0,A.x1*A.x1)*(A.y1*A.y1*A.y1),maximumD(A.x0*A.x0,A.x1*A.x1)*(A.y0*A.y0*A.y0),maximumD(A.x0*A.x0,A.x1*A.x1)*(A.y1*A.y1*A.y1))))+A.y0*A.y0*A.y0*A.y0*A.y0+FAKTORAim;
-	fA.y1=maximumD(seedC0re*A.y0,seedC0re*A.y1,seedC1re*A.y0,seedC1re*A.y1)+maximumD(seedC0im*A.x0,seedC0im*A.x1,seedC1im*A.x0,seedC1im*A.x1)+5*maximumD(minimumD(A.x0*A.x0*A.x0*A.x0,A.x1*A.x1*A.x1*A.x1)*A.y0,minimumD(A.x0*A.x0*A.x0*A.x0,A.x1*A.x1*A.x1*A.x1)*A.y1,maximumD(A.x0*A.x0*A.x0*A.x0,A.x1*A.x1*A.x1*A.x1)*A.y0,maximumD(A.x0*A.x0*A.x0*A.x0,A.x1*A.x1*A.x1*A.x1)*A.y1)-(2*(5*minimumD(minimumD(A.x0*A.x0,A.x1*A.x1)*(A.y0*A.y0*A.y0),minimumD(A.x0*A.x0,A.x1*A.x1)*(A.y1*A.y1*A.y1),maximumD(A.x0*A.x0,A.x1*A.x1)*(A.y0*A.y0*A.y0),maximumD(A.x0*A.x0,A.x1*A.x1)*(A.y1*A.y1*A.y1))))+A.y1*A.y1*A.y1*A.y1*A.y1+FAKTORAim;
+template<class RECT>
+inline void bbxfA_z5cza(RECT& A,RECT& fA) {
+	typedef NumCore<typename RECT::SCALAR> NC;
+	fA.x0=minimumD(NC::seedC0re*A.x0,NC::seedC0re*A.x1,NC::seedC1re*A.x0,NC::seedC1re*A.x1)-maximumD(NC::seedC0im*A.y0,NC::seedC0im*A.y1,NC::seedC1im*A.y0,NC::seedC1im*A.y1)+A.x0*A.x0*A.x0*A.x0*A.x0-(2*(5*maximumD((A.x0*A.x0*A.x0)*minimumD(A.y0*A.y0,A.y1*A.y1),(A.x0*A.x0*A.x0)*maximumD(A.y0*A.y0,A.y1*A.y1),(A.x1*A.x1*A.x1)*minimumD(A.y0*A.y0,A.y1*A.y1),(A.x1*A.x1*A.x1)*maximumD(A.y0*A.y0,A.y1*A.y1))))+5*minimumD(A.x0*minimumD(A.y0*A.y0*A.y0*A.y0,A.y1*A.y1*A.y1*A.y1),A.x0*maximumD(A.y0*A.y0*A.y0*A.y0,A.y1*A.y1*A.y1*A.y1),A.x1*minimumD(A.y0*A.y0*A.y0*A.y0,A.y1*A.y1*A.y1*A.y1),A.x1*maximumD(A.y0*A.y0*A.y0*A.y0,A.y1*A.y1*A.y1*A.y1))+NC::FAKTORAre;
+	fA.x1=maximumD(NC::seedC0re*A.x0,NC::seedC0re*A.x1,NC::seedC1re*A.x0,NC::seedC1re*A.x1)-minimumD(NC::seedC0im*A.y0,NC::seedC0im*A.y1,NC::seedC1im*A.y0,NC::seedC1im*A.y1)+A.x1*A.x1*A.x1*A.x1*A.x1-(2*(5*minimumD((A.x0*A.x0*A.x0)*minimumD(A.y0*A.y0,A.y1*A.y1),(A.x0*A.x0*A.x0)*maximumD(A.y0*A.y0,A.y1*A.y1),(A.x1*A.x1*A.x1)*minimumD(A.y0*A.y0,A.y1*A.y1),(A.x1*A.x1*A.x1)*maximumD(A.y0*A.y0,A.y1*A.y1))))+5*maximumD(A.x0*minimumD(A.y0*A.y0*A.y0*A.y0,A.y1*A.y1*A.y1*A.y1),A.x0*maximumD(A.y0*A.y0*A.y0*A.y0,A.y1*A.y1*A.y1*A.y1),A.x1*minimumD(A.y0*A.y0*A.y0*A.y0,A.y1*A.y1*A.y1*A.y1),A.x1*maximumD(A.y0*A.y0*A.y0*A.y0,A.y1*A.y1*A.y1*A.y1))+NC::FAKTORAre;
+	fA.y0=minimumD(NC::seedC0re*A.y0,NC::seedC0re*A.y1,NC::seedC1re*A.y0,NC::seedC1re*A.y1)+minimumD(NC::seedC0im*A.x0,NC::seedC0im*A.x1,NC::seedC1im*A.x0,NC::seedC1im*A.x1)+5*minimumD(minimumD(A.x0*A.x0*A.x0*A.x0,A.x1*A.x1*A.x1*A.x1)*A.y0,minimumD(A.x0*A.x0*A.x0*A.x0,A.x1*A.x1*A.x1*A.x1)*A.y1,maximumD(A.x0*A.x0*A.x0*A.x0,A.x1*A.x1*A.x1*A.x1)*A.y0,maximumD(A.x0*A.x0*A.x0*A.x0,A.x1*A.x1*A.x1*A.x1)*A.y1)-(2*(5*maximumD(minimumD(A.x0*A.x0,A.x1*A.x1)*(A.y0*A.y0*A.y0),minimumD(A.x0*A.x0,A.x1*A.x1)*(A.y1*A.y1*A.y1),maximumD(A.x0*A.x0,A.x1*A.x1)*(A.y0*A.y0*A.y0),maximumD(A.x0*A.x0,A.x1*A.x1)*(A.y1*A.y1*A.y1))))+A.y0*A.y0*A.y0*A.y0*A.y0+NC::FAKTORAim;
+	fA.y1=maximumD(NC::seedC0re*A.y0,NC::seedC0re*A.y1,NC::seedC1re*A.y0,NC::seedC1re*A.y1)+maximumD(NC::seedC0im*A.x0,NC::seedC0im*A.x1,NC::seedC1im*A.x0,NC::seedC1im*A.x1)+5*maximumD(minimumD(A.x0*A.x0*A.x0*A.x0,A.x1*A.x1*A.x1*A.x1)*A.y0,minimumD(A.x0*A.x0*A.x0*A.x0,A.x1*A.x1*A.x1*A.x1)*A.y1,maximumD(A.x0*A.x0*A.x0*A.x0,A.x1*A.x1*A.x1*A.x1)*A.y0,maximumD(A.x0*A.x0*A.x0*A.x0,A.x1*A.x1*A.x1*A.x1)*A.y1)-(2*(5*minimumD(minimumD(A.x0*A.x0,A.x1*A.x1)*(A.y0*A.y0*A.y0),minimumD(A.x0*A.x0,A.x1*A.x1)*(A.y1*A.y1*A.y1),maximumD(A.x0*A.x0,A.x1*A.x1)*(A.y0*A.y0*A.y0),maximumD(A.x0*A.x0,A.x1*A.x1)*(A.y1*A.y1*A.y1))))+A.y1*A.y1*A.y1*A.y1*A.y1+NC::FAKTORAim;
 }
 
-// z^6+A*z+c
-void getBoundingBoxfA_z6azc(PlaneRect& A,PlaneRect& fA) {
-	fA.x0=seedC0re+minimumD(FAKTORAre*A.x0,FAKTORAre*A.x1)-maximumD(FAKTORAim*A.y0,FAKTORAim*A.y1)+minimumD(A.x0*A.x0*A.x0*A.x0*A.x0*A.x0,A.x1*A.x1*A.x1*A.x1*A.x1*A.x1)-(3*(5*maximumD(minimumD(A.x0*A.x0*A.x0*A.x0,A.x1*A.x1*A.x1*A.x1)*minimumD(A.y0*A.y0,A.y1*A.y1),minimumD(A.x0*A.x0*A.x0*A.x0,A.x1*A.x1*A.x1*A.x1)*maximumD(A.y0*A.y0,A.y1*A.y1),maximumD(A.x0*A.x0*A.x0*A.x0,A.x1*A.x1*A.x1*A.x1)*minimumD(A.y0*A.y0,A.y1*A.y1),maximumD(A.x0*A.x0*A.x0*A.x0,A.x1*A.x1*A.x1*A.x1)*maximumD(A.y0*A.y0,A.y1*A.y1))))+3*(5*minimumD(minimumD(A.x0*A.x0,A.x1*A.x1)*minimumD(A.y0*A.y0*A.y0*A.y0,A.y1*A.y1*A.y1*A.y1),minimumD(A.x0*A.x0,A.x1*A.x1)*maximumD(A.y0*A.y0*A.y0*A.y0,A.y1*A.y1*A.y1*A.y1),maximumD(A.x0*A.x0,A.x1*A.x1)*minimumD(A.y0*A.y0*A.y0*A.y0,A.y1*A.y1*A.y1*A.y1),maximumD(A.x0*A.x0,A.x1*A.x1)*maximumD(A.y0*A.y0*A.y0*A.y0,A.y1*A.y1*A.y1*A.y1)))-maximumD(A.y0*A.y0*A.y0*A.y0*A.y0*A.y0,A.y1*A.y1*A.y1*A.y1*A.y1*A.y1);
-	fA.x1=seedC1re+maximumD(FAKTORAre*A.x0,FAKTORAre*A.x1)-minimumD(FAKTORAim*A.y0,FAKTORAim*A.y1)+maximumD(A.x0*A.x0*A.x0*A.x0*A.x0*A.x0,A.x1*A.x1*A.x1*A.x1*A.x1*A.x1)-(3*(5*minimumD(minimumD(A.x0*A.x0*A.x0*A.x0,A.x1*A.x1*A.x1*A.x1)*minimumD(A.y0*A.y0,A.y1*A.y1),minimumD(A.x0*A.x0*A.x0*A.x0,A.x1*A.x1*A.x1*A.x1)*maximumD(A.y0*A.y0,A.y1*A.y1),maximumD(A.x0*A.x0*A.x0*A.x0,A.x1*A.x1*A.x1*A.x1)*minimumD(A.y0*A.y0,A.y1*A.y1),maximumD(A.x0*A.x0*A.x0*A.x0,A.x1*A.x1*A.x1*A.x1)*maximumD(A.y0*A.y0,A.y1*A.y1))))+3*(5*maximumD(minimumD(A.x0*A.x0,A.x1*A.x1)*minimumD(A.y0*A.y0*A.y0*A.y0,A.y1*A.y1*A.y1*A.y1),minimumD(A.x0*A.x0,A.x1*A.x1)*maximumD(A.y0*A.y0*A.y0*A.y0,A.y1*A.y1*A.y1*A.y1),maximumD(A.x0*A.x0,A.x1*A.x1)*minimumD(A.y0*A.y0*A.y0*A.y0,A.y1*A.y1*A.y1*A.y1),maximumD(A.x0*A.x0,A.x1*A.x1)*maximumD(A.y0*A.y0*A.y0*A.y0,A.y1*A.y1*A.y1*A.y1)))-minimumD(A.y0*A.y0*A.y0*A.y0*A.y0*A.y0,A.y1*A.y1*A.y1*A.y1*A.y1*A.y1);
-	fA.y0=minimumD(FAKTORAre*A.y0,FAKTORAre*A.y1)+minimumD(FAKTORAim*A.x0,FAKTORAim*A.x1)+6*minimumD((A.x0*A.x0*A.x0*A.x0*A.x0)*A.y0,(A.x0*A.x0*A.x0*A.x0*A.x0)*A.y1,(A.x1*A.x1*A.x1*A.x1*A.x1)*A.y0,(A.x1*A.x1*A.x1*A.x1*A.x1)*A.y1)-(4*(5*maximumD((A.x0*A.x0*A.x0)*(A.y0*A.y0*A.y0),(A.x0*A.x0*A.x0)*(A.y1*A.y1*A.y1),(A.x1*A.x1*A.x1)*(A.y0*A.y0*A.y0),(A.x1*A.x1*A.x1)*(A.y1*A.y1*A.y1))))+6*minimumD(A.x0*(A.y0*A.y0*A.y0*A.y0*A.y0),A.x0*(A.y1*A.y1*A.y1*A.y1*A.y1),A.x1*(A.y0*A.y0*A.y0*A.y0*A.y0),A.x1*(A.y1*A.y1*A.y1*A.y1*A.y1))+seedC0im;
-	fA.y1=maximumD(FAKTORAre*A.y0,FAKTORAre*A.y1)+maximumD(FAKTORAim*A.x0,FAKTORAim*A.x1)+6*maximumD((A.x0*A.x0*A.x0*A.x0*A.x0)*A.y0,(A.x0*A.x0*A.x0*A.x0*A.x0)*A.y1,(A.x1*A.x1*A.x1*A.x1*A.x1)*A.y0,(A.x1*A.x1*A.x1*A.x1*A.x1)*A.y1)-(4*(5*minimumD((A.x0*A.x0*A.x0)*(A.y0*A.y0*A.y0),(A.x0*A.x0*A.x0)*(A.y1*A.y1*A.y1),(A.x1*A.x1*A.x1)*(A.y0*A.y0*A.y0),(A.x1*A.x1*A.x1)*(A.y1*A.y1*A.y1))))+6*maximumD(A.x0*(A.y0*A.y0*A.y0*A.y0*A.y0),A.x0*(A.y1*A.y1*A.y1*A.y1*A.y1),A.x1*(A.y0*A.y0*A.y0*A.y0*A.y0),A.x1*(A.y1*A.y1*A.y1*A.y1*A.y1))+seedC1im;
+// z^N+A*z+c for any degree N, expanded at compile time:
+// Re and Im of (x+iy)^N are sums of binomial(N,k)*x^(N-k)*y^k,
+// every such term is the product of two power intervals taken
+// from tables computed once per cell. Used for all zNazc from N=3
+
+constexpr int64_t binomial(const int32_t n,const int32_t k) {
+	return (k <= 0) ? 1 : binomial(n,k-1)*(n-k+1)/k;
 }
 
-char* seedCstr225(char* erg) {
-	sprintf(erg,"c_ia_%I64d_%I64d_x_%I64d_%I64d",
-		(int64_t)floor(DENOM225*seedC0re),
-		(int64_t)floor(DENOM225*seedC1re),
-		(int64_t)floor(DENOM225*seedC0im),
-		(int64_t)floor(DENOM225*seedC1im)
-	);
-	return erg;
+template<int N,class E>
+struct PowerTable {
+	// interval [lo[k],hi[k]] of x^k for the cell's x-interval
+	// (cells never contain 0 in their interior)
+	E lo[N+1],hi[N+1];
+	E p0,p1;
+};
+
+// powers K..N of the interval [a0,a1], p0,p1 holding a0^(K-1),a1^(K-1)
+template<int K,int N,class E,bool DONE=(K > N)>
+struct PowerSteps {
+	static inline void set(const E& a0,const E& a1,PowerTable<N,E>& pt) {
+		pt.p0=pt.p0*a0;
+		pt.p1=pt.p1*a1;
+		if (K & 1) {
+			pt.lo[K]=pt.p0;
+			pt.hi[K]=pt.p1;
+		} else {
+			pt.lo[K]=minimumD(pt.p0,pt.p1);
+			pt.hi[K]=maximumD(pt.p0,pt.p1);
+		}
+		PowerSteps<K+1,N,E>::set(a0,a1,pt);
+	}
+};
+
+template<int K,int N,class E>
+struct PowerSteps<K,N,E,true> {
+	static inline void set(const E&,const E&,PowerTable<N,E>&) {}
+};
+
+template<int N,class E>
+inline void setpowertable(const E& a0,const E& a1,PowerTable<N,E>& pt) {
+	pt.p0=a0;
+	pt.p1=a1;
+	pt.lo[1]=a0;
+	pt.hi[1]=a1;
+	PowerSteps<2,N,E>::set(a0,a1,pt);
 }
 
-char* FAKTORAstr225(char* erg) {
-	sprintf(erg,"A_%I64d_%I64d",
-		(int64_t)floor(DENOM225*FAKTORAre),
-		(int64_t)floor(DENOM225*FAKTORAim)
-	);
+// adds the terms k=K..N of Re resp. Im of (x+iy)^N
+template<int N,int K,class RECT,class E,bool DONE=(K > N)>
+struct ZNTerms {
+	static inline void add(PowerTable<N,E>& px,PowerTable<N,E>& py,RECT& fA) {
+		const typename RECT::SCALAR coeff=(typename RECT::SCALAR)binomial(N,K);
+		E lo,hi;
+		if (K == 0) {
+			lo=px.lo[N];
+			hi=px.hi[N];
+		} else if (K == N) {
+			lo=py.lo[N];
+			hi=py.hi[N];
+		} else {
+			lo=minimumD(px.lo[N-K]*py.lo[K],px.lo[N-K]*py.hi[K],px.hi[N-K]*py.lo[K],px.hi[N-K]*py.hi[K]);
+			hi=maximumD(px.lo[N-K]*py.lo[K],px.lo[N-K]*py.hi[K],px.hi[N-K]*py.lo[K],px.hi[N-K]*py.hi[K]);
+		}
+		if ( (K > 0) && (K < N) ) {
+			lo=coeff*lo;
+			hi=coeff*hi;
+		}
 		
-	return erg;
+		// i^K: real for even, imaginary for odd K, negative
+		// for K=2,3 mod 4
+		if ( (K & 2) == 0) {
+			if ( (K & 1) == 0) { fA.x0 += lo; fA.x1 += hi; }
+			else { fA.y0 += lo; fA.y1 += hi; }
+		} else {
+			if ( (K & 1) == 0) { fA.x0 -= hi; fA.x1 -= lo; }
+			else { fA.y0 -= hi; fA.y1 -= lo; }
+		}
+		
+		ZNTerms<N,K+1,RECT,E>::add(px,py,fA);
+	}
+};
+
+template<int N,int K,class RECT,class E>
+struct ZNTerms<N,K,RECT,E,true> {
+	static inline void add(PowerTable<N,E>&,PowerTable<N,E>&,RECT&) {}
+};
+
+template<int N>
+struct ZNAZC {
+	template<class RECT>
+	static inline void bbx(RECT& A,RECT& fA) {
+		typedef NumCore<typename RECT::SCALAR> NC;
+		typedef decltype(A.x0) E;
+		PowerTable<N,E> px,py;
+		setpowertable<N>(A.x0,A.x1,px);
+		setpowertable<N>(A.y0,A.y1,py);
+		
+		fA.x0=minimumD(NC::FAKTORAre*A.x0,NC::FAKTORAre*A.x1)-maximumD(NC::FAKTORAim*A.y0,NC::FAKTORAim*A.y1);
+		fA.x1=maximumD(NC::FAKTORAre*A.x0,NC::FAKTORAre*A.x1)-minimumD(NC::FAKTORAim*A.y0,NC::FAKTORAim*A.y1);
+		fA.y0=minimumD(NC::FAKTORAre*A.y0,NC::FAKTORAre*A.y1)+minimumD(NC::FAKTORAim*A.x0,NC::FAKTORAim*A.x1);
+		fA.y1=maximumD(NC::FAKTORAre*A.y0,NC::FAKTORAre*A.y1)+maximumD(NC::FAKTORAim*A.x0,NC::FAKTORAim*A.x1);
+		ZNTerms<N,0,RECT,E>::add(px,py,fA);
+		fA.x0 += NC::seedC0re;
+		fA.x1 += NC::seedC1re;
+		fA.y0 += NC::seedC0im;
+		fA.y1 += NC::seedC1im;
+	}
+};
+
+// MIXED: getScreenRectfA in double for a cell of a level in a higher
+// type. Cell edges, c and A are exact in double, every bound of the
+// bounding box is off by at most grid.errorD from the exact one (and
+// from that in T). Returns -1 if a comparison with local, the complete
+// square or a pixel edge is within that distance, T has to decide
+template<class T>
+inline int getScreenRectfA_double(CmGrid<T>& grid,PlaneRectT<T>& A,ScreenRect& scr) {
+	PlaneRectT<double> AD,bbxfA;
+	AD.x0=(double)A.x0;
+	AD.x1=(double)A.x1;
+	AD.y0=(double)A.y0;
+	AD.y1=(double)A.y1;
+	NumCore<double>::getBoundingBoxfA(AD,bbxfA);
+	
+	const double e=grid.errorD;
+	const double C0=NumCore<double>::COMPLETE0,C1=NumCore<double>::COMPLETE1;
+	PlaneRectT<double>& L=grid.localD;
+	// certainly not inside
+	if (
+		(bbxfA.x0 < L.x0-e) || (bbxfA.x1 > L.x1+e) || (bbxfA.y0 < L.y0-e) || (bbxfA.y1 > L.y1+e) ||
+		(bbxfA.x0 < C0-e) || (bbxfA.x1 > C1+e) || (bbxfA.y0 < C0-e) || (bbxfA.y1 > C1+e)
+	) {
+		return 0;
+	}
+	// within e of an edge of local or the complete square
+	if (
+		(bbxfA.x0 < L.x0+e) || (bbxfA.x1 > L.x1-e) || (bbxfA.y0 < L.y0+e) || (bbxfA.y1 > L.y1-e) ||
+		(bbxfA.x0 < C0+e) || (bbxfA.x1 > C1-e) || (bbxfA.y0 < C0+e) || (bbxfA.y1 > C1-e)
+	) {
+		return -1;
+	}
+	
+	// the pixels of both ends of the error interval
+	const double s=grid.scalePixelPerRangeD;
+	const double b[4]={bbxfA.x0,bbxfA.x1,bbxfA.y0,bbxfA.y1};
+	int32_t p[4];
+	for(int32_t k=0;k<4;k++) {
+		p[k]=(int)floor( (b[k]-e-C0)*s );
+		if ( (int)floor( (b[k]+e-C0)*s ) != p[k]) return -1;
+	}
+	scr.x0=p[0];
+	scr.x1=p[1];
+	scr.y0=p[2];
+	scr.y1=p[3];
+	
+	return 1;
 }
 
-int getfuncidx(const char* s) {
-	for(int32_t i=0;i<FUNCANZ;i++) {
-		if (!strcmp(s,funcname[i])) return i;
+// MIXED: error bound of a bound of getBoundingBoxfA in double, from
+// the kernels' operations (u=2^-53, gamma(k)=k*u/(1-k*u)):
+// - ZNAZC<N>: x^j is j-1 products of the power table, a term
+//   binomial(N,K)*x^(N-K)*y^K (binomial exact) at most N roundings,
+//   A*x and A*y one. min/max over rounded endpoint products is off
+//   by at most the error of the largest candidate.
+// - a bound sums at most N/2+1 terms of (x+iy)^N, two A terms and c
+//   (exact) recursively: N+3 additions.
+// - bbxfA_z2c/z2azc: one product per term, at most 5 terms.
+// So every term is off by gamma(2N+3) relative to its absolute value
+// (gamma(a)+gamma(b)+gamma(a)gamma(b) <= gamma(a+b)), and the absolute
+// values over a cell in the complete square (|x|,|y| <= R) sum to at
+// most S=(|x|+|y|)^N+|A|R+|c| <= (2R)^N+|A|R+|c|. Doubled for the
+// roundings of the comparisons (operands at most S, the pixel scale a
+// power of 2) and the error of the bound in the level's type
+double mixederror(void) {
+	const double R=(double)COMPLETE1;
+	const double a=fabs((double)FAKTORAre)+fabs((double)FAKTORAim);
+	const double c=maximumD(fabs((double)seedC0re),fabs((double)seedC1re))+maximumD(fabs((double)seedC0im),fabs((double)seedC1im));
+	const double S=pow(2*R,fkt.grad)+a*R+c;
+	const double ku=(2*fkt.grad+3)*ldexp(1.0,-53);
+	return 2.0*S*ku/(1.0-ku);
+}
+
+// bounding box of cell A and the screen rectangle it intersects
+// returns 0 if the bounding box is not entirely within the cycle
+// enclosement (local) or the complete square: then the cell
+// is potentially white regardless of the current bitmap
+template<class T>
+inline int getScreenRectfA(CmGrid<T>& grid,PlaneRectT<T>& A,ScreenRect& scr) {
+	if (grid.mixed > 0) {
+		int r=getScreenRectfA_double(grid,A,scr);
+		if (r >= 0) return r;
+		if (grid.nexact) grid.nexact->fetch_add(1,std::memory_order_relaxed);
 	}
 	
-	return -1;
+	PlaneRectT<T> bbxfA;
+	NumCore<T>::getBoundingBoxfA(A,bbxfA);
+
+	if (
+		(SQUARE_LIES_ENTIRELY_IN_LOCAL(bbxfA,grid.local) <= 0) ||
+		(SQUARE_LIES_ENTIRELY_IN_COMPLETE(bbxfA,NumCore<T>::COMPLETE0,NumCore<T>::COMPLETE1) <= 0)
+	) {
+		return 0;
+	}
+
+	scr.x0=scrcoord_as_lowerleft(bbxfA.x0,grid.scalePixelPerRange);
+	scr.x1=scrcoord_as_lowerleft(bbxfA.x1,grid.scalePixelPerRange);
+	scr.y0=scrcoord_as_lowerleft(bbxfA.y0,grid.scalePixelPerRange);
+	scr.y1=scrcoord_as_lowerleft(bbxfA.y1,grid.scalePixelPerRange);
+	// scr is in "screen", i.e. >= 0 and < SCREENWIDTH in all coordinates
+
+	return 1;
 }
 
-void setfunc(const int32_t afunc) {
-	fkt.clearCoeff();
-	COMPUTECOMMANDLINE[0]=0;
+// getScreenRectfA for the gray cells (bits of agray set) of a word
+// starting at pixel xcoord0 in the row A.y0..A.y1. Bit b of the return
+// value is set if cell b's bounding box lies in local and the complete
+// square, only then scr[b] is valid.
+// A macro, not a template: the vector compares must be compiled
+// for the instruction set of the instance, not lowered beforehand
+#define DEFINE_WORDKERNEL(NAME,V,ATTR)\
+template<void (*BBX)(PlaneRectBatch<V>&,PlaneRectBatch<V>&)>\
+ATTR DDBYTE NAME(CmGrid<double>& grid,PlaneRectT<double>& A,const int32_t xcoord0,const DDBYTE agray,ScreenRect* scr) {\
+	const int32_t W=sizeof(V)/sizeof(double);\
+	PlaneRectBatch<V> AV,bbxfA,LV;\
+	V zero={};\
+	AV.y0=zero+A.y0;\
+	AV.y1=zero+A.y1;\
+	LV.x0=zero+grid.local.x0;\
+	LV.x1=zero+grid.local.x1;\
+	LV.y0=zero+grid.local.y0;\
+	LV.y1=zero+grid.local.y1;\
+	V C0=zero+NumCore<double>::COMPLETE0;\
+	V C1=zero+NumCore<double>::COMPLETE1;\
+	\
+	DDBYTE inside=0;\
+	for(int32_t b0=0;b0<32;b0+=W) {\
+		/* all POTW */\
+		if ( ((agray >> b0) & ((1 << W)-1)) == 0) continue;\
+		\
+		V xc;\
+		for(int32_t lane=0;lane<W;lane++) xc[lane]=xcoord0+b0+lane;\
+		AV.x0=xc*grid.scaleRangePerPixel + NumCore<double>::COMPLETE0;\
+		AV.x1=AV.x0+grid.scaleRangePerPixel;\
+		BBX(AV,bbxfA);\
+		\
+		/* SQUARE_LIES_ENTIRELY_IN_LOCAL and _IN_COMPLETE as selects */\
+		V in=(LV.x0 <= bbxfA.x0) ? zero+1 : zero;\
+		in=(bbxfA.x1 <= LV.x1) ? in : zero;\
+		in=(LV.y0 <= bbxfA.y0) ? in : zero;\
+		in=(bbxfA.y1 <= LV.y1) ? in : zero;\
+		in=(C0 <= bbxfA.x0) ? in : zero;\
+		in=(bbxfA.x1 <= C1) ? in : zero;\
+		in=(C0 <= bbxfA.y0) ? in : zero;\
+		in=(bbxfA.y1 <= C1) ? in : zero;\
+		\
+		/* scrcoord_as_lowerleft lane-wise */\
+		PlaneRectBatch<V> sc;\
+		sc.x0=(bbxfA.x0 - NumCore<double>::COMPLETE0) * grid.scalePixelPerRange;\
+		sc.x1=(bbxfA.x1 - NumCore<double>::COMPLETE0) * grid.scalePixelPerRange;\
+		sc.y0=(bbxfA.y0 - NumCore<double>::COMPLETE0) * grid.scalePixelPerRange;\
+		sc.y1=(bbxfA.y1 - NumCore<double>::COMPLETE0) * grid.scalePixelPerRange;\
+		\
+		for(int32_t lane=0;lane<W;lane++) {\
+			if (in[lane] == 0) continue;\
+			int32_t bit=b0+lane;\
+			inside |= ((DDBYTE)1 << bit);\
+			scr[bit].x0=(int)floor(sc.x0[lane]);\
+			scr[bit].x1=(int)floor(sc.x1[lane]);\
+			scr[bit].y0=(int)floor(sc.y0[lane]);\
+			scr[bit].y1=(int)floor(sc.y1[lane]);\
+		}\
+	}\
+	\
+	return inside & agray;\
+}
 
-	switch (afunc) {
-		case FUNC_Z3AZC: {
-			getBoundingBoxfA=getBoundingBoxfA_z3azc;
-			fkt.setCoeff(3,1);
-			fkt.setCoeff(1,cplxA);
-			fkt.setCoeff(0,cplxC);
-			sprintf(COMPUTECOMMANDLINE,"func=z3azc c=%.20lg,%.20lg A=%.20lg,%.20lg cmd=period,-1",
-				(double)cplxC.re,(double)cplxC.im,
-				(double)cplxA.re,(double)cplxA.im
-			);
-			break;
-		} 
-		case FUNC_Z4AZC: {
-			getBoundingBoxfA=getBoundingBoxfA_z4azc;
-			fkt.setCoeff(4,1);
-			fkt.setCoeff(1,cplxA);
-			fkt.setCoeff(0,cplxC);
-			sprintf(COMPUTECOMMANDLINE,"func=z4azc c=%.20lg,%.20lg A=%.20lg,%.20lg cmd=period,-1",
-				(double)cplxC.re,(double)cplxC.im,
-				(double)cplxA.re,(double)cplxA.im
-			);
-			break;
-		}
-		case FUNC_Z5AZC: {
-			getBoundingBoxfA=getBoundingBoxfA_z5azc;
-			fkt.setCoeff(5,1);
-			fkt.setCoeff(1,cplxA);
-			fkt.setCoeff(0,cplxC);
-			sprintf(COMPUTECOMMANDLINE,"func=z5azc c=%.20lg,%.20lg A=%.20lg,%.20lg cmd=period,-1",
-				(double)cplxC.re,(double)cplxC.im,
+// one instance per instruction set, chosen at runtime. Contraction
+// to FMA is switched off as the vector results must be identical
+// to the scalar ones
+#pragma GCC push_options
+#pragma GCC optimize ("fp-contract=off")
+
+DEFINE_WORDKERNEL(getScreenRectfA_word_generic,V2NTYP,__attribute__((flatten)))
+#if defined(__x86_64__) || defined(__i386__)
+DEFINE_WORDKERNEL(getScreenRectfA_word_avx2,V4NTYP,__attribute__((target("avx2"),flatten)))
+DEFINE_WORDKERNEL(getScreenRectfA_word_avx512,V8NTYP,__attribute__((target("avx512f"),flatten)))
+#endif
+
+#pragma GCC pop_options
+
+// resolves SIMD=auto and falls back if the CPU lacks 
+// the requested instruction set
+int getsimd(const int32_t asimd) {
+	if (asimd == SIMD_OFF) return SIMD_OFF;
+	#if defined(__x86_64__) || defined(__i386__)
+	__builtin_cpu_init();
+	if ( (asimd >= SIMD_AVX512) && (__builtin_cpu_supports("avx512f")) ) return SIMD_AVX512;
+	if ( (asimd >= SIMD_AVX2) && (__builtin_cpu_supports("avx2")) ) return SIMD_AVX2;
+	#endif
+	return SIMD_GENERIC;
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+#define SETWORDKERNEL(BBX) \
+{\
+	switch (_SIMD) {\
+		case SIMD_AVX512: getScreenRectfA_word=getScreenRectfA_word_avx512<BBX<PlaneRectBatch<V8NTYP> > >; break;\
+		case SIMD_AVX2: getScreenRectfA_word=getScreenRectfA_word_avx2<BBX<PlaneRectBatch<V4NTYP> > >; break;\
+		case SIMD_GENERIC: getScreenRectfA_word=getScreenRectfA_word_generic<BBX<PlaneRectBatch<V2NTYP> > >; break;\
+		default: getScreenRectfA_word=NULL; break;\
+	}\
+	wordkernellanes=(_SIMD == SIMD_AVX512 ? 8 : (_SIMD == SIMD_AVX2 ? 4 : 2));\
+}
+#else
+#define SETWORDKERNEL(BBX) \
+{\
+	if (_SIMD != SIMD_OFF) getScreenRectfA_word=getScreenRectfA_word_generic<BBX<PlaneRectBatch<V2NTYP> > >;\
+	else getScreenRectfA_word=NULL;\
+	wordkernellanes=2;\
+}
+#endif
+
+// bounding-box function of all number types and the word kernel
+#define SETKERNELS(BBX) \
+{\
+	NumCore<double>::getBoundingBoxfA=BBX<PlaneRectT<double> >;\
+	NumCore<long double>::getBoundingBoxfA=BBX<PlaneRectT<long double> >;\
+	NumCore<__float128>::getBoundingBoxfA=BBX<PlaneRectT<__float128> >;\
+	NumCore<Dyadic128>::getBoundingBoxfA=BBX<PlaneRectT<Dyadic128> >;\
+	NumCore<Dyadic192>::getBoundingBoxfA=BBX<PlaneRectT<Dyadic192> >;\
+	NumCore<Dyadic256>::getBoundingBoxfA=BBX<PlaneRectT<Dyadic256> >;\
+	NumCore<DoubleDouble>::getBoundingBoxfA=BBX<PlaneRectT<DoubleDouble> >;\
+	SETWORDKERNEL(BBX)\
+}
+
+template<class T>
+void setnumcore(void) {
+	NumCore<T>::seedC0re=(T)seedC0re;
+	NumCore<T>::seedC1re=(T)seedC1re;
+	NumCore<T>::seedC0im=(T)seedC0im;
+	NumCore<T>::seedC1im=(T)seedC1im;
+	NumCore<T>::FAKTORAre=(T)FAKTORAre;
+	NumCore<T>::FAKTORAim=(T)FAKTORAim;
+	NumCore<T>::COMPLETE0=(T)COMPLETE0;
+	NumCore<T>::COMPLETE1=(T)COMPLETE1;
+}
+
+// PRECISION=dy: integer bits all values of a level fit in and
+// the exponent of the complete square. Set per parameter set
+int32_t dyadicintbits=35,dyadicexponent=1;
+
+// the integer part of the bounding boxes is bounded by
+// (|x|+|y|)^N+|A|*(|x|+|y|)+|c| <= 3*2^((e+1)*N) for cells in the
+// 2^e-square, the pixel coordinates by 2^31. Sign bit extra
+void setdyadic(void) {
+	dyadicexponent=0;
+	while ( ((int64_t)1 << dyadicexponent) < (int64_t)COMPLETE1) dyadicexponent++;
+	dyadicintbits=(dyadicexponent+1)*fkt.grad+3;
+	if (dyadicintbits < 34) dyadicintbits=34;
+	Dyadic128::F=128-dyadicintbits;
+	Dyadic192::F=192-dyadicintbits;
+	Dyadic256::F=256-dyadicintbits;
+}
+
+// narrowest fixed-point width exact at level alevel: cell edges
+// have p=alevel-e-1 fraction bits, the N-th powers N*p, the terms
+// with c or A 25+p. Beyond 256 bits float128
+int dyadicprecision(const int32_t alevel) {
+	int32_t p=alevel-dyadicexponent-1;
+	if (p < 0) p=0;
+	int32_t need=fkt.grad*p;
+	if (need < 25+p) need=25+p;
+	if (need <= Dyadic128::F) return PRECISION_DY128;
+	if (need <= Dyadic192::F) return PRECISION_DY192;
+	if (need <= Dyadic256::F) return PRECISION_DY256;
+	return PRECISION_QD;
+}
+
+// number type level alevel is analyzed in
+int levelprecision(const int32_t alevel) {
+	if (_PRECISION == PRECISION_DY) return dyadicprecision(alevel);
+	if (_PRECISION != PRECISION_AUTO) return _PRECISION;
+	
+	if (alevel <= precisionlimit[_FUNC][0]) return PRECISION_D;
+	if (alevel <= precisionlimit[_FUNC][1]) return PRECISION_LD;
+	return PRECISION_QD;
+}
+
+// the vector word kernel exists only for double
+template<class T>
+inline int wordkernel(CmGrid<T>&,PlaneRectT<T>&,const int32_t,const DDBYTE,ScreenRect*,DDBYTE&) {
+	return 0;
+}
+
+inline int wordkernel(CmGrid<double>& grid,PlaneRectT<double>& A,const int32_t xcoord0,const DDBYTE agray,ScreenRect* scr,DDBYTE& erg) {
+	if (!getScreenRectfA_word) return 0;
+	erg=getScreenRectfA_word(grid,A,xcoord0,agray,scr);
+	return 1;
+}
+
+// METRICS: bounding boxes the word kernel computes for the gray
+// cells agray, a batch of wordkernellanes cells if one is gray
+inline int32_t wordkernelboxes(const DDBYTE agray) {
+	if (wordkernellanes <= 0) return __builtin_popcount(agray);
+	
+	int32_t n=0;
+	for(int32_t b0=0;b0<32;b0+=wordkernellanes) {
+		if ( ((agray >> b0) & ((1 << wordkernellanes)-1)) != 0) n += wordkernellanes;
+	}
+	
+	return n;
+}
+
+// wall time in seconds since an arbitrary start
+double wallseconds(void) {
+	return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// calls rowfunc(y) for every y in ay0..ay1 on athreads threads
+// rows are handed out in chunks as threads become free. An
+// exception in a row (fail() within a library call) stops handing
+// out rows and is rethrown on the calling thread after all joined
+template<class ROWFUNC>
+void parallel_rows(const int32_t athreads,const int32_t ay0,const int32_t ay1,ROWFUNC& rowfunc) {
+	if ( (athreads <= 1) || ((ay1-ay0) < ROWCHUNK) ) {
+		for(int32_t y=ay0;y<=ay1;y++) rowfunc(y);
+		return;
+	}
+	
+	std::atomic<int32_t> nexty(ay0);
+	std::exception_ptr failure=NULL;
+	std::mutex failuremutex;
+	auto worker=[&](void) {
+		try {
+			while (1) {
+				int32_t ys=nexty.fetch_add(ROWCHUNK);
+				if (ys > ay1) break;
+				int32_t ye=ys+ROWCHUNK-1;
+				if (ye > ay1) ye=ay1;
+				for(int32_t y=ys;y<=ye;y++) rowfunc(y);
+			}
+		} catch (...) {
+			std::lock_guard<std::mutex> lock(failuremutex);
+			if (!failure) failure=std::current_exception();
+			nexty.store(ay1+1);
+		}
+	};
+	
+	std::thread* th=new std::thread[athreads-1];
+	for(int32_t t=0;t<(athreads-1);t++) {
+		th[t]=std::thread(worker);
+	}
+	worker();
+	for(int32_t t=0;t<(athreads-1);t++) {
+		th[t].join();
+	}
+	delete[] th;
+	if (failure) std::rethrow_exception(failure);
+}
+
+char* seedCstr225(char* erg) {
+	sprintf(erg,"c_ia_%I64d_%I64d_x_%I64d_%I64d",
+		(int64_t)floor(DENOM225*seedC0re),
+		(int64_t)floor(DENOM225*seedC1re),
+		(int64_t)floor(DENOM225*seedC0im),
+		(int64_t)floor(DENOM225*seedC1im)
+	);
+	return erg;
+}
+
+char* FAKTORAstr225(char* erg) {
+	sprintf(erg,"A_%I64d_%I64d",
+		(int64_t)floor(DENOM225*FAKTORAre),
+		(int64_t)floor(DENOM225*FAKTORAim)
+	);
+		
+	return erg;
+}
+
+// CACHE: what a level's outcome for cycle aroot depends on,
+// parameters as in seedCstr225/FAKTORAstr225
+char* cyclecachekey(Root& aroot,const DDBYTE astartwith,const int32_t aencw,char* erg) {
+	char fn[16];
+	if (_FUNC == FUNC_ZNAZC) sprintf(fn,"z%iazc",_DEGREE);
+	else strcpy(fn,funcname[_FUNC]);
+	sprintf(erg,"%s c=%lld,%lld A=%lld,%lld encw=%i %s %s cycle=%i,%i",
+		fn,
+		(long long)floor(DENOM225*seedC0re),
+		(long long)floor(DENOM225*seedC0im),
+		(long long)floor(DENOM225*FAKTORAre),
+		(long long)floor(DENOM225*FAKTORAim),
+		aencw,
+		(astartwith == ALL32GRAY ? "gray" : "potw"),
+		NNTYPSTR,
+		aroot.cyclenumber,aroot.cyclelen
+	);
+	
+	return erg;
+}
+
+int getfuncidx(const char* s) {
+	for(int32_t i=0;i<FUNC_ZNAZC;i++) {
+		if (!strcmp(s,funcname[i])) return i;
+	}
+	
+	int32_t n;
+	char rest[8];
+	if (sscanf(s,"Z%iAZ%7s",&n,rest) == 2) {
+		if ( 
+			(!strcmp(rest,"C")) &&
+			(n >= 7) && (n < MAXDEGREE)
+		) {
+			_DEGREE=n;
+			return FUNC_ZNAZC;
+		}
+	}
+	
+	return -1;
+}
+
+// kernels of z^N+A*z+c for N=K..MAXDEGREE-1, sets the one of
+// degree adegree
+template<int K,bool DONE=(K >= MAXDEGREE)>
+struct ZNKernels {
+	static void set(const int32_t adegree) {
+		if (adegree == K) {
+			SETKERNELS(ZNAZC<K>::template bbx)
+		} else {
+			ZNKernels<K+1>::set(adegree);
+		}
+	}
+};
+
+template<int K>
+struct ZNKernels<K,true> {
+	static void set(const int32_t) {}
+};
+
+void setfunc(const int32_t afunc) {
+	fkt.clearCoeff();
+	COMPUTECOMMANDLINE[0]=0;
+
+	switch (afunc) {
+		case FUNC_Z3AZC: {
+			SETKERNELS(ZNAZC<3>::template bbx)
+			fkt.setCoeff(3,1);
+			fkt.setCoeff(1,cplxA);
+			fkt.setCoeff(0,cplxC);
+			sprintf(COMPUTECOMMANDLINE,"func=z3azc c=%.20lg,%.20lg A=%.20lg,%.20lg cmd=period,-1",
+				(double)cplxC.re,(double)cplxC.im,
+				(double)cplxA.re,(double)cplxA.im
+			);
+			break;
+		} 
+		case FUNC_Z4AZC: {
+			SETKERNELS(ZNAZC<4>::template bbx)
+			fkt.setCoeff(4,1);
+			fkt.setCoeff(1,cplxA);
+			fkt.setCoeff(0,cplxC);
+			sprintf(COMPUTECOMMANDLINE,"func=z4azc c=%.20lg,%.20lg A=%.20lg,%.20lg cmd=period,-1",
+				(double)cplxC.re,(double)cplxC.im,
+				(double)cplxA.re,(double)cplxA.im
+			);
+			break;
+		}
+		case FUNC_Z5AZC: {
+			SETKERNELS(ZNAZC<5>::template bbx)
+			fkt.setCoeff(5,1);
+			fkt.setCoeff(1,cplxA);
+			fkt.setCoeff(0,cplxC);
+			sprintf(COMPUTECOMMANDLINE,"func=z5azc c=%.20lg,%.20lg A=%.20lg,%.20lg cmd=period,-1",
+				(double)cplxC.re,(double)cplxC.im,
 				(double)cplxA.re,(double)cplxA.im
 			);
 			break;
 		}
 		case FUNC_Z6AZC: {
-			getBoundingBoxfA=getBoundingBoxfA_z6azc;
+			SETKERNELS(ZNAZC<6>::template bbx)
 			fkt.setCoeff(6,1);
 			fkt.setCoeff(1,cplxA);
 			fkt.setCoeff(0,cplxC);
@@ -411,7 +1656,7 @@ void setfunc(const int32_t afunc) {
 			break;
 		}
 		case FUNC_Z2AZC: {
-			getBoundingBoxfA=getBoundingBoxfA_z2azc;
+			SETKERNELS(bbxfA_z2azc)
 			fkt.setCoeff(2,1);
 			fkt.setCoeff(1,cplxA);
 			fkt.setCoeff(0,cplxC);
@@ -421,8 +1666,20 @@ void setfunc(const int32_t afunc) {
 			);
 			break;
 		}
+		case FUNC_ZNAZC: {
+			ZNKernels<7>::set(_DEGREE);
+			fkt.setCoeff(_DEGREE,1);
+			fkt.setCoeff(1,cplxA);
+			fkt.setCoeff(0,cplxC);
+			sprintf(COMPUTECOMMANDLINE,"func=z%iazc c=%.20lg,%.20lg A=%.20lg,%.20lg cmd=period,-1",
+				_DEGREE,
+				(double)cplxC.re,(double)cplxC.im,
+				(double)cplxA.re,(double)cplxA.im
+			);
+			break;
+		}
 		default: {
-			getBoundingBoxfA=getBoundingBoxfA_z2c;
+			SETKERNELS(bbxfA_z2c)
 			fkt.setCoeff(2,1);
 			fkt.setCoeff(0,cplxC);
 			sprintf(COMPUTECOMMANDLINE,"func=z2c c=%.20lg,%.20lg cmd=period,-1",
@@ -433,826 +1690,4423 @@ void setfunc(const int32_t afunc) {
 	} // switch
 }
 
-// struct ArrayByteManager
+// struct TextBuffer
 
-ArrayDDByteManager::ArrayDDByteManager() {
-	current=NULL;
-	allocatedIdx=0;
-	freeFromIdx=-1;
-	anzptr=0;
-	double d=CHUNKSIZE; d /= sizeof(DDBYTE);
-	allocatePerBlock=(int)floor(d);
+TextBuffer::TextBuffer() {
+	text=NULL;
+	len=allocated=0;
 }
 
-void ArrayDDByteManager::FreeAll(void) {
-	for(int32_t i=0;i<anzptr;i++) {
-		delete[] ptr[i];
-	}
-	current=NULL;
-	anzptr=0;
+TextBuffer::~TextBuffer() {
+	if (text) delete[] text;
 }
 
-ArrayDDByteManager::~ArrayDDByteManager() {
-	FreeAll();
+void TextBuffer::clear(void) {
+	len=0;
+	if (text) text[0]=0;
 }
 
-PDDBYTE ArrayDDByteManager::getMemory(const int32_t aanz) {
-	if (anzptr >= (MAXPTR-8)) {
-		LOGMSG("ArrayDDByteManager:: Zu wenig Speicher\n");
-		exit(99);
-	}
-	if (
-		(!current) ||
-		((freeFromIdx + aanz + 2) >= allocatedIdx)
-	) {
-		printf("x");
-		ptr[anzptr]=current=new DDBYTE[allocatePerBlock];
-		anzptr++;
-		if (!current) {
-			LOGMSG("Memory-Fehler. ArrayByteManager.\n");
-			exit(99);
+void TextBuffer::vappend(const char* fmt,va_list args) {
+	va_list args2;
+	va_copy(args2,args);
+	int32_t n=vsnprintf(NULL,0,fmt,args2);
+	va_end(args2);
+	if (n < 0) return;
+	
+	if ( (len+n+1) > allocated) {
+		int32_t neu=2*allocated;
+		if (neu < (len+n+1)) neu=len+n+1024;
+		char* t=new char[neu];
+		if (text) {
+			memcpy(t,text,len+1);
+			delete[] text;
 		}
-		freeFromIdx=0;
-		allocatedIdx=allocatePerBlock;
+		text=t;
+		allocated=neu;
 	}
 	
-	PDDBYTE p=&current[freeFromIdx];
-	freeFromIdx += aanz;
-	return p;
+	vsnprintf(&text[len],allocated-len,fmt,args);
+	len += n;
 }
 
-char* upper(char* s) {
-	if (!s) return NULL;
-	for(int32_t i=(strlen(s)-1);i>=0;i--) {
-		if ((s[i]>='a')&&(s[i]<='z')) s[i]=s[i]-'a'+'A';
+void TextBuffer::append(const char* fmt,...) {
+	va_list args;
+	va_start(args,fmt);
+	vappend(fmt,args);
+	va_end(args);
+}
+
+// struct CmTask
+
+CmTask::CmTask() {
+	threads=1;
+	out=NULL;
+	rows=NULL;
+	tiles=NULL;
+	ckpt=NULL;
+	ckptfn[0]=resumefn[0]=0;
+	exportfn[0]=0;
+	exportlevel=0;
+}
+
+// progress output of a cm_local analysis
+void cmprintf(CmTask& task,const char* fmt,...) {
+	va_list args;
+	va_start(args,fmt);
+	if (task.out) task.out->vappend(fmt,args);
+	else vprintf(fmt,args);
+	va_end(args);
+}
+
+// struct TiledBitmap
+
+TiledBitmap::TiledBitmap() {
+	anztiles=maxtiles=0;
+	tilem=tiley=NULL;
+	tilewithgray=NULL;
+	words=NULL;
+	wordsmapped=0;
+	wordsallocated=0;
+	bytesallocated=0;
+	dense=NULL;
+	densetm0=densety0=denselenm=denseleny=0;
+	hash=NULL;
+	hashmask=0;
+}
+
+TiledBitmap::~TiledBitmap() {
+	FreeAll();
+}
+
+void TiledBitmap::FreeAll(void) {
+	clearTiles();
+	freeWords();
+}
+
+void TiledBitmap::freeWords(void) {
+	if (words) {
+		int64_t bytes=wordsallocated*sizeof(DDBYTE);
+		#ifdef _MMAPAVAILABLE
+		if (wordsmapped>0) munmap(words,(size_t)bytes);
+		else
+		#endif
+		{
+			delete[] words;
+			blocksinram.fetch_sub(bytes);
+		}
 	}
+	wordsmapped=0;
+	words=NULL;
+	wordsallocated=0;
+}
 
-	return s;
+// removes all tiles, the memory of the words is kept
+// for the next allocateWords
+void TiledBitmap::clearTiles(void) {
+	if (tilem) delete[] tilem;
+	if (tiley) delete[] tiley;
+	if (tilewithgray) delete[] tilewithgray;
+	if (dense) delete[] dense;
+	if (hash) delete[] hash;
+	tilem=tiley=NULL;
+	tilewithgray=NULL;
+	dense=NULL;
+	hash=NULL;
+	anztiles=maxtiles=0;
+	hashmask=0;
 }
 
-int newton(
-	Polynom& polyf,
-	Polynom& polyabl,
-	const Complex astart,
-	Complex& erg) 
-{
-	Complex z=astart,f,fabl,zletzt,d;
+// room for at most amax tiles within tile coordinates
+// atm0..atm1 x aty0..aty1, removes all tiles
+void TiledBitmap::setMaxTiles(
+	const int64_t amax,
+	const int32_t atm0,const int32_t atm1,
+	const int32_t aty0,const int32_t aty1
+) {
+	clearTiles();
+	if (amax >= (INT32_MAX >> 2)) {
+		LOGMSG("TiledBitmap: too many tiles\n");
+		fail();
+	}
+	maxtiles=(int32_t)amax;
+	tilem=new int32_t[maxtiles+1];
+	tiley=new int32_t[maxtiles+1];
+	tilewithgray=new int8_t[maxtiles+1];
+	if ( (!tilem) || (!tiley) || (!tilewithgray) ) {
+		LOGMSG("Memory error. TiledBitmap\n");
+		fail();
+	}
 	
-	for(int32_t i=1;i<MAXIT;i++) {
-		zletzt=z;
-		// z(n+1)=zn-f(zn) / f'(zn);
-		polyf.eval_arg_f(z,f);
-		polyabl.eval_arg_f(z,fabl);
-		z = z - f / fabl;
-		d = z-zletzt;
-		if (d.normQ() < ZEROEPSILON) {
-			erg=z;
-			return i;
+	int64_t densesize=(int64_t)(atm1-atm0+1)*(aty1-aty0+1);
+	if (densesize <= TILEDENSEMAX) {
+		densetm0=atm0;
+		densety0=aty0;
+		denselenm=atm1-atm0+1;
+		denseleny=aty1-aty0+1;
+		dense=new int32_t[densesize];
+		if (!dense) {
+			LOGMSG("Memory error. TiledBitmap/3\n");
+			fail();
 		}
+		for(int64_t i=0;i<densesize;i++) dense[i]=-1;
+		return;
 	}
 	
-	return 0;
+	uint32_t hlen=2;
+	while (hlen < (2*(uint32_t)maxtiles)) hlen <<= 1;
+	hashmask=hlen-1;
+	hash=new int32_t[hlen];
+	if (!hash) {
+		LOGMSG("Memory error. TiledBitmap/4\n");
+		fail();
+	}
+	for(uint32_t i=0;i<hlen;i++) hash[i]=-1;
 }
 
-int getNullstellenIdx(const Complex aw,const int32_t ait) {
-	for(int32_t i=0;i<nbr_of_cp;i++) {
-		Complex d=zero[i].attractor- aw;
-		if (d.normQ() < ZEROEPSILON) {
-			return i;
-		}
+inline uint32_t tilehash(const int32_t atm,const int32_t aty) {
+	uint64_t key=( (uint64_t)(uint32_t)aty << 32) | (uint32_t)atm;
+	return (uint32_t)( (key*0x9E3779B97F4A7C15ULL) >> 32);
+}
+
+// tile number of tile (atm,aty) or -1
+inline int32_t TiledBitmap::findTile(const int32_t atm,const int32_t aty) {
+	if (dense) {
+		uint32_t dm=(uint32_t)(atm-densetm0);
+		uint32_t dy=(uint32_t)(aty-densety0);
+		if ( (dm >= (uint32_t)denselenm) || (dy >= (uint32_t)denseleny) ) return -1;
+		return dense[(int64_t)dy*denselenm+dm];
 	}
-	if (nbr_of_cp > (MAXZEROS-8)) {
-		LOGMSG("Error. Too many roots.\n");
-		exit(99);
+	
+	uint32_t h=tilehash(atm,aty) & hashmask;
+	while (hash[h] >= 0) {
+		int32_t t=hash[h];
+		if ( (tilem[t] == atm) && (tiley[t] == aty) ) return t;
+		h=(h+1) & hashmask;
 	}
 	
-	zero[nbr_of_cp].clear();
-	zero[nbr_of_cp].attractor=aw;
-	nbr_of_cp++;
+	return -1;
+}
 
-	return (nbr_of_cp-1);
+int32_t TiledBitmap::addTile(const int32_t atm,const int32_t aty) {
+	int32_t t=findTile(atm,aty);
+	if (t >= 0) return t;
+	if (anztiles >= maxtiles) {
+		LOGMSG("Implementation error. TiledBitmap full\n");
+		fail();
+	}
+	tilem[anztiles]=atm;
+	tiley[anztiles]=aty;
+	tilewithgray[anztiles]=1;
+	if (dense) {
+		dense[(int64_t)(aty-densety0)*denselenm+(atm-densetm0)]=anztiles;
+	} else {
+		uint32_t h=tilehash(atm,aty) & hashmask;
+		while (hash[h] >= 0) h=(h+1) & hashmask;
+		hash[h]=anztiles;
+	}
+	anztiles++;
+	
+	return anztiles-1;
 }
 
-int getLagrange(Polynom& f) {
-	// i.e. Douady
-	double res=1.0;
-	for(int32_t i=0;i<=f.grad;i++) {
-		res += fkt.coeff[i].norm();
+// bits of a and b interleaved, a in the even ones
+inline uint64_t mortonkey(const uint32_t a,const uint32_t b) {
+	uint64_t erg=0;
+	for(int32_t i=0;i<32;i++) {
+		erg |= ( (uint64_t)((a >> i) & 0b1) << (2*i) ) | ( (uint64_t)((b >> i) & 0b1) << (2*i+1) );
 	}
-	res /= fkt.coeff[fkt.grad].norm();
-	int expo=(int)ceil(log(ceil(res))/log(2.0));
-	return (1 << expo);
+	return erg;
 }
 
-void ableitenFA(Polynom& infkt,Polynom& ergabl) {
-	ergabl.clearCoeff();
+// renumbers the tiles added in Z-order of their coordinates,
+// before allocateWords
+void TiledBitmap::mortonOrder(void) {
+	if (anztiles <= 1) return;
 	
-	for(int32_t i=1;i<=infkt.grad;i++) {
-		if (infkt.coeffnull[i]==0) {
-			ergabl.setCoeff(
-				i-1,
-				Complex(i,0)*infkt.coeff[i]
-			);
+	int32_t tm0=tilem[0],ty0=tiley[0];
+	for(int32_t t=1;t<anztiles;t++) {
+		if (tilem[t] < tm0) tm0=tilem[t];
+		if (tiley[t] < ty0) ty0=tiley[t];
+	}
+	uint64_t* key=new uint64_t[anztiles];
+	int32_t* order=new int32_t[anztiles];
+	int32_t* tmp=new int32_t[anztiles];
+	if ( (!key) || (!order) || (!tmp) ) {
+		LOGMSG("Memory error. TiledBitmap/5\n");
+		fail();
+	}
+	for(int32_t t=0;t<anztiles;t++) {
+		key[t]=mortonkey(tilem[t]-tm0,tiley[t]-ty0);
+		order[t]=t;
+	}
+	std::sort(order,order+anztiles,[&](const int32_t a,const int32_t b) { return (key[a] < key[b]); });
+	
+	for(int32_t t=0;t<anztiles;t++) tmp[t]=tilem[order[t]];
+	for(int32_t t=0;t<anztiles;t++) tilem[t]=tmp[t];
+	for(int32_t t=0;t<anztiles;t++) tmp[t]=tiley[order[t]];
+	for(int32_t t=0;t<anztiles;t++) tiley[t]=tmp[t];
+	for(int32_t t=0;t<anztiles;t++) {
+		tilewithgray[t]=1;
+		if (dense) {
+			dense[(int64_t)(tiley[t]-densety0)*denselenm+(tilem[t]-densetm0)]=t;
+		}
+	}
+	if (!dense) {
+		for(uint32_t h=0;h<=hashmask;h++) hash[h]=-1;
+		for(int32_t t=0;t<anztiles;t++) {
+			uint32_t h=tilehash(tilem[t],tiley[t]) & hashmask;
+			while (hash[h] >= 0) h=(h+1) & hashmask;
+			hash[h]=t;
 		}
 	}
+	
+	delete[] key;
+	delete[] order;
+	delete[] tmp;
 }
 
-int ps_construct_critical_orbits(void) {
-	double escapeQ=COMPLETE1*COMPLETE1;
-	int cyclenumber=1;
-	int returnvalue=0;
+// memory for the tiles added, all POTW
+void TiledBitmap::allocateWords(void) {
+	int64_t len=(int64_t)anztiles*TILEWORDS;
+	if ( (words) && (wordsallocated < (len+1)) ) freeWords();
+	int64_t bytes=(len+1)*sizeof(DDBYTE);
+	if (words) {
+		// large enough from an earlier level
+	} else if ( (_MEMLIMIT > 0) && ( (blocksinram.load()+bytes) > _MEMLIMIT) ) {
+		words=getMappedBlock(bytes);
+		wordsmapped=1;
+		bytesallocated += bytes;
+	} else {
+		words=new DDBYTE[len+1];
+		blocksinram.fetch_add(bytes);
+		bytesallocated += bytes;
+	}
+	if (!words) {
+		LOGMSG("Memory error. TiledBitmap/2\n");
+		fail();
+	}
+	if (wordsallocated < (len+1)) wordsallocated=len+1;
+	for(int64_t i=0;i<len;i++) words[i]=ALL32POTW;
+}
 
-	Complex *orbit=new Complex[MAXIT];
-	int orbitlen=0;
+// word am (absolute mem position) of row ay, NULL if not stored
+inline PDDBYTE TiledBitmap::getWord(const int32_t am,const int32_t ay) {
+	int32_t t=findTile(am >> TILESHIFTM,ay >> TILESHIFTY);
+	if (t < 0) return NULL;
 	
-	Polynom polyabl;
-	ableitenFA(fkt,polyabl);
-	
-	for(int32_t cp=0;cp<nbr_of_cp;cp++) {
-		Complex z0=zero[cp].attractor;
-		
-		Complex zn=z0;
-		int esc=0;
-		orbitlen=0;
-		for(int32_t i=0;i<MAXIT;i++) {
-			orbit[orbitlen]=zn;
-			orbitlen++;
-			if (zn.normQ() > escapeQ) {
-				esc=1;
-				break;
-			}
-			Complex tmp;
-			fkt.eval_arg_f(zn,tmp);
-			zn=tmp;
-		} // i
-		
-		if (esc>0) {
-			zero[cp].clear();
-			continue;
-		}
-		
-		// bounded critical orbit
-		// is it periodic ?
-		int cyclestart=-1,cycleend=orbitlen-1;
-		for(int32_t i=(orbitlen-2);i>=0;i--) {
-			Complex d=orbit[i]-orbit[orbitlen-1];
-			if (d.normQ() < ZEROEPSILON) {
-				cyclestart=i;
-				break;
-			}
-		}
-		
-		// not periodic
-		if (cyclestart < 0) {
-			// not periodic
-			zero[cp].clear();
-			continue;
+	return &words[
+		(int64_t)t*TILEWORDS + 
+		( (ay & (TILEROWS-1)) << TILESHIFTM) + 
+		(am & (TILEMEMS-1))
+	];
+}
+
+// struct ResultCache
+
+ResultCache::ResultCache() {
+	f=NULL;
+	hash=NULL;
+	black=NULL;
+	anz=0;
+	hashmask=0;
+}
+
+ResultCache::~ResultCache() {
+	close();
+}
+
+// no cache any more, the file is kept
+void ResultCache::close(void) {
+	if (f) fclose(f);
+	if (hash) delete[] hash;
+	if (black) delete[] black;
+	f=NULL;
+	hash=NULL;
+	black=NULL;
+	anz=0;
+	hashmask=0;
+}
+
+uint64_t cacheentryhash(const char* akey,const int32_t alevel,const char* aprec) {
+	char tmp[64];
+	sprintf(tmp," L%i %s",alevel,aprec);
+	// FNV-1a
+	uint64_t h=0xcbf29ce484222325ULL;
+	for(const char* p=akey;*p;p++) h=(h ^ (uint8_t)*p)*0x100000001b3ULL;
+	for(const char* p=tmp;*p;p++) h=(h ^ (uint8_t)*p)*0x100000001b3ULL;
+	if (h == 0) h=1;
+	
+	return h;
+}
+
+void ResultCache::insert(const uint64_t ah,const int8_t ablack) {
+	if ( (2*(anz+1)) > (int64_t)hashmask) {
+		// twice the size
+		uint64_t oldmask=hashmask;
+		uint64_t* oldhash=hash;
+		int8_t* oldblack=black;
+		hashmask=(oldmask > 0 ? 2*oldmask+1 : 1023);
+		hash=new uint64_t[hashmask+1];
+		black=new int8_t[hashmask+1];
+		if ( (!hash) || (!black) ) {
+			LOGMSG("Memory error. ResultCache\n");
+			fail();
 		}
-		
-		// periodic orbit
-		// start: cyclestart+1 .. cycleend
-		// (orbit point at [cyclestart] is identical to [cycleend]
-		
-		// has an earlier analyzed critical point already
-		// found that orbit ?
-		// then discard this one here
-		int found=0;
-		for(int32_t cpprev=0;cpprev<cp;cpprev++) {
-			for(int32_t k=0;k<zero[cpprev].cyclelen;k++) {
-				Complex d=zero[cpprev].cycle[k].pp - orbit[cycleend];
-				if (d.normQ() < ZEROEPSILON) {
-					found=1;
-					break;
-				}
+		for(uint64_t i=0;i<=hashmask;i++) hash[i]=0;
+		anz=0;
+		if (oldhash) {
+			for(uint64_t i=0;i<=oldmask;i++) {
+				if (oldhash[i] != 0) insert(oldhash[i],oldblack[i]);
 			}
-			if (found>0) break;
-		} // cpprev
-		
-		if (found>0) {
-			// previously found cycle
-			// this cp is marked as uninteresting
-			zero[cp].clear();
-			continue;
+			delete[] oldhash;
+			delete[] oldblack;
 		}
-		
-		zero[cp].cyclelen=cycleend - (cyclestart+1) + 1;
-		zero[cp].cycle=new PeriodicPoint[zero[cp].cyclelen + 8];
-		Complex multiplier=Complex(1,0);
-		for(int32_t i=(cyclestart+1);i<=cycleend;i++) {
-			zero[cp].cycle[i-(cyclestart+1)].pp=orbit[i];
-			Complex der;
-			polyabl.eval_arg_f(orbit[i],der);
-			multiplier = multiplier*der;
+	}
+	
+	uint64_t i=ah & hashmask;
+	while (hash[i] != 0) {
+		if (hash[i] == ah) {
+			black[i]=ablack;
+			return;
 		}
-		zero[cp].multiplier=multiplier.norm();
-		zero[cp].cyclenumber=cyclenumber;
-		cyclenumber++;
-		if (zero[cp].multiplier > 1.00001) {
-			// a little buffer
-			// repelling
-			zero[cp].cyclelen=0;
-			delete[] zero[cp].cycle;
-			zero[cp].cycle=NULL;
-			zero[cp].interiorfound=0;
+		i=(i+1) & hashmask;
+	}
+	hash[i]=ah;
+	black[i]=ablack;
+	anz++;
+}
+
+// reads the entries of file afn and appends new ones to it
+void ResultCache::open(const char* afn) {
+	FILE* fin=fopen(afn,"rt");
+	if (fin) {
+		char line[4096];
+		while (fgets(line,sizeof(line),fin)) {
+			// key Llevel datatype black|none
+			int32_t len=strlen(line);
+			while ( (len > 0) && ( (line[len-1] == '\n') || (line[len-1] == '\r') ) ) line[--len]=0;
+			char* sp3=strrchr(line,' ');
+			if (!sp3) continue;
+			*sp3=0;
+			char* sp2=strrchr(line,' ');
+			if (!sp2) continue;
+			*sp2=0;
+			char* sp1=strrchr(line,' ');
+			if (!sp1) continue;
+			*sp1=0;
+			int32_t level;
+			if (sscanf(sp1+1,"L%i",&level) != 1) continue;
+			insert(cacheentryhash(line,level,sp2+1),(strcmp(sp3+1,"black") == 0));
 		}
-		
-		returnvalue++;
-		
-	} // cp
+		fclose(fin);
+	}
+	
+	f=fopen(afn,"at");
+	if (!f) {
+		LOGMSG2("Error. Cache file %s not writeable.\n",afn);
+		fail();
+	}
+}
+
+// 1 black, 0 no black, -1 level not in the cache
+int8_t ResultCache::lookup(const char* akey,const int32_t alevel,const char* aprec) {
+	if (!f) return -1;
 	
-	delete[] orbit;
+	uint64_t h=cacheentryhash(akey,alevel,aprec);
+	std::lock_guard<std::mutex> lock(m);
+	if (!hash) return -1;
+	uint64_t i=h & hashmask;
+	while (hash[i] != 0) {
+		if (hash[i] == h) return black[i];
+		i=(i+1) & hashmask;
+	}
 	
-	return returnvalue;
+	return -1;
 }
 
-void ps_find_critical_points(void) {
-	// fkt: iterated function
-	// cp: zeros of 1st order derivative
-	Polynom fktforcp,ablforcp;
-	ableitenFA(fkt,fktforcp);
-	ableitenFA(fktforcp,ablforcp);
+void ResultCache::store(const char* akey,const int32_t alevel,const char* aprec,const int8_t ablack) {
+	if (!f) return;
 	
-	double ESCAPEQ=COMPLETE1*COMPLETE1;
+	std::lock_guard<std::mutex> lock(m);
+	insert(cacheentryhash(akey,alevel,aprec),ablack);
+	// one line per write, so SWEEP workers appending to the
+	// same file do not interleave
+	fprintf(f,"%s L%i %s %s\n",akey,alevel,aprec,(ablack > 0 ? "black" : "none"));
+	fflush(f);
+}
 
-	int32_t LEN=1024;
-	// 3 times ESCAPER: far away from the roots, so dynamics
-	// here are tame: cvhannels to infinity as in paper byy Schleicher
-	// about the universal set of Newton starting points
-	int32_t SCRRE0=-3*ESCAPEQ;
-	int32_t SCRIM0=-3*ESCAPEQ;
-	int32_t SCRIM1= 3*ESCAPEQ;
-	NTYP sk=SCRIM1-SCRIM0; sk /= LEN;
+// struct CheckpointHeader
+
+const char CHECKPOINTMAGIC[8]="TSACP02";
+
+// writes header ah and, if ah.level > 0, the bitmap (rows
+// ispotwY or tiles) to afn. Rows and tiles that are all POTW only
+// get a flag. Written to a temporary file first, so a preempted
+// job leaves the previous checkpoint intact
+int8_t writecheckpoint(const char* afn,CheckpointHeader& ah,PDDBYTE* ispotwY,TiledBitmap& tiles) {
+	#ifdef _FORKAVAILABLE
+	// BENCH: the process is preempted after that many checkpoints
+	if ( (benchpreempt > 0) && (benchckptwritten >= benchpreempt) ) _exit(0);
+	#endif
 	
-	Complex start;
-	nbr_of_cp=0;
-	#define SUCHE(X0,Y0,X1,Y1)\
+	char tmpfn[1200];
+	sprintf(tmpfn,"%s.tmp",afn);
+	FILE* f=fopen(tmpfn,"wb");
+	if (!f) return 0;
+	
+	memcpy(ah.magic,CHECKPOINTMAGIC,sizeof(ah.magic));
+	int8_t ok=(fwrite(&ah,sizeof(ah),1,f) == 1);
+	
+	// flag per row/tile: 0 not stored, 1 all POTW, 2 words follow
+	#define WRITEWORDS(PTR,LEN) \
 	{\
-	int yd=1,xd=1;\
-	if ((Y0) > (Y1)) yd=-1; else if ((Y0) < (Y1)) yd=1; \
-	if ((X0) > (X1)) xd=-1; else if ((X0) < (X1)) xd=1; \
-	for(int32_t y=(Y0);y<=(Y1);y+=yd) {\
-		start.im=y*sk + SCRIM0;\
-		for(int32_t x=(X0);x<=(X1);x+=xd) {\
-			start.re=x*sk + SCRRE0; \
-			\
-			Complex nulls;\
-			int32_t it=newton(fktforcp,ablforcp,start,nulls);\
-			if (it > 0) {\
-				getNullstellenIdx(nulls,it);\
-				if (nbr_of_cp >= fktforcp.grad) break;\
-			} \
-		} \
-		if (nbr_of_cp >= fktforcp.grad) break;\
-	} \
+		int8_t flag=0;\
+		if (PTR) {\
+			flag=1;\
+			for(int64_t i=0;i<(LEN);i++) {\
+				if ((PTR)[i] != ALL32POTW) {\
+					flag=2;\
+					break;\
+				}\
+			}\
+		}\
+		if (fwrite(&flag,sizeof(flag),1,f) != 1) ok=0;\
+		if ( (flag == 2) && (fwrite((PTR),sizeof(DDBYTE),(LEN),f) != (size_t)(LEN)) ) ok=0;\
 	}
-
-	// searches all border pixels of the underlying image in the 3 times Lagrange estimate
-	// (modified after Hubbard, Schleicher, Sutherland. How to find all roots of complex polynomials, 2001)
 	
-	SUCHE(0,0,0,LEN-1)
-	if (nbr_of_cp < fktforcp.grad) {
-		SUCHE(0,LEN-1,LEN-1,LEN-1)
-	}
-	if (nbr_of_cp < fktforcp.grad) {
-		SUCHE(LEN-1,LEN-1,LEN-1,0)
+	if (ah.level > 0) {
+		if (ah.tiled > 0) {
+			for(int32_t t=0;t<tiles.anztiles;t++) {
+				if (fwrite(&tiles.tilem[t],sizeof(int32_t),1,f) != 1) ok=0;
+				if (fwrite(&tiles.tiley[t],sizeof(int32_t),1,f) != 1) ok=0;
+				WRITEWORDS(&tiles.words[(int64_t)t*TILEWORDS],TILEWORDS)
+			}
+		} else {
+			for(int32_t y=0;y<ah.leny;y++) {
+				WRITEWORDS(ispotwY[y],ah.lenx)
+			}
+		}
 	}
-	if (nbr_of_cp < fktforcp.grad) {
-		SUCHE(LEN-1,0,0,0)
+	
+	if (fclose(f) != 0) ok=0;
+	if ( (ok <= 0) || (rename(tmpfn,afn) != 0) ) {
+		remove(tmpfn);
+		return 0;
 	}
+	benchckptwritten++;
+	
+	return 1;
 }
 
-// Complex
-
-void Complex::output(FILE* f) {
-	fprintf(f,"%.20lg%+.20lgi",(double)re,(double)im);
+int8_t readcheckpointheader(const char* afn,CheckpointHeader& ah) {
+	FILE* f=fopen(afn,"rb");
+	if (!f) return 0;
+	
+	int8_t ok=(fread(&ah,sizeof(ah),1,f) == 1);
+	fclose(f);
+	if (ok <= 0) return 0;
+	if (memcmp(ah.magic,CHECKPOINTMAGIC,sizeof(ah.magic)) != 0) return 0;
+	ah.key[sizeof(ah.key)-1]=0;
+	
+	return 1;
 }
 
-Complex Complex::operator*(const Complex a) {
-    Complex ret(a.re*re-a.im*im, a.im*re+a.re*im);
-
-    return ret;
+// the bitmap of the level in progress into the allocated and
+// initialized rows ispotwY or tiles of the geometry of ah. Returns 0
+// if the file does not match
+int8_t readcheckpointbitmap(const char* afn,CheckpointHeader& ah,PDDBYTE* ispotwY,TiledBitmap& tiles) {
+	FILE* f=fopen(afn,"rb");
+	if (!f) return 0;
+	
+	CheckpointHeader h;
+	int8_t ok=(fread(&h,sizeof(h),1,f) == 1);
+	if (
+		(ok <= 0) ||
+		(h.level != ah.level) ||
+		(h.tiled != ah.tiled) ||
+		(h.enclosementall.x0 != ah.enclosementall.x0) ||
+		(h.enclosementall.x1 != ah.enclosementall.x1) ||
+		(h.enclosementall.y0 != ah.enclosementall.y0) ||
+		(h.enclosementall.y1 != ah.enclosementall.y1) ||
+		(h.mem0 != ah.mem0) ||
+		(h.lenx != ah.lenx) ||
+		(h.leny != ah.leny) ||
+		(h.anztiles != ah.anztiles)
+	) {
+		fclose(f);
+		return 0;
+	}
+	
+	#define READWORDS(PTR,LEN) \
+	{\
+		int8_t flag;\
+		if (fread(&flag,sizeof(flag),1,f) != 1) ok=0;\
+		else if ( (flag > 0) && (!(PTR)) ) ok=0;\
+		else if (flag == 1) {\
+			for(int64_t i=0;i<(LEN);i++) (PTR)[i]=ALL32POTW;\
+		} else if (flag == 2) {\
+			if (fread((PTR),sizeof(DDBYTE),(LEN),f) != (size_t)(LEN)) ok=0;\
+		}\
+	}
+	
+	if (h.tiled > 0) {
+		for(int32_t t=0;(t<h.anztiles) && (ok>0);t++) {
+			int32_t tm,ty;
+			if (
+				(fread(&tm,sizeof(tm),1,f) != 1) ||
+				(fread(&ty,sizeof(ty),1,f) != 1)
+			) {
+				ok=0;
+				break;
+			}
+			int32_t nr=tiles.findTile(tm,ty);
+			PDDBYTE p=NULL;
+			if (nr >= 0) p=&tiles.words[(int64_t)nr*TILEWORDS];
+			READWORDS(p,TILEWORDS)
+		}
+	} else {
+		for(int32_t y=0;(y<h.leny) && (ok>0);y++) {
+			READWORDS(ispotwY[y],h.lenx)
+		}
+	}
+	fclose(f);
+	
+	return ok;
 }
 
-Complex::Complex(const NTYP r, const NTYP i) {
-	re=r;
-	im=i;
-}
+// struct ExportHeader
 
-Complex operator/(const Complex& a,const Complex& b) {
-    const NTYP n2=b.re*b.re+b.im*b.im;
-    Complex ret(
-		(a.re*b.re+a.im*b.im)/n2,
-		(a.im*b.re-a.re*b.im) / n2
-    );
+const char EXPORTMAGIC[8]="TSABM01";
 
-    return ret;
+// writes header ah and the pixels ah.pixels from the rows ispotwY
+// (over ah.enclosementall, words from mem0 on) or the tiles to afn
+// as runs per row
+int8_t writeexport(const char* afn,ExportHeader& ah,PDDBYTE* ispotwY,TiledBitmap& tiles,const int8_t atiled,const int32_t mem0) {
+	FILE* f=fopen(afn,"wb");
+	if (!f) return 0;
+	
+	memcpy(ah.magic,EXPORTMAGIC,sizeof(ah.magic));
+	int8_t ok=(fwrite(&ah,sizeof(ah),1,f) == 1);
+	
+	const ScreenRect& all=ah.pixels;
+	int32_t* runs=new int32_t[all.x1-all.x0+3];
+	if (!runs) {
+		LOGMSG("Memory error. writeexport\n");
+		fail();
+	}
+	for(int32_t y=all.y0;(y<=all.y1) && (ok>0);y++) {
+		PDDBYTE row=NULL;
+		if (atiled <= 0) row=ispotwY[y-ah.enclosementall.y0];
+		int32_t anzruns=1;
+		int32_t color=SQUARE_POTW;
+		runs[0]=0;
+		for(int32_t x=all.x0;x<=all.x1;x++) {
+			PDDBYTE w=NULL;
+			if (atiled > 0) w=tiles.getWord(x >> SHIFTPERDDBYTE,y);
+			else if (row) w=&row[(x >> SHIFTPERDDBYTE)-mem0];
+			int32_t c=( (!w) ? SQUARE_POTW : ( ((*w) >> (x & ((1 << SHIFTPERDDBYTE)-1))) & 0b1 ) );
+			if (c != color) {
+				runs[anzruns]=0;
+				anzruns++;
+				color=c;
+			}
+			runs[anzruns-1]++;
+		}
+		if (fwrite(&anzruns,sizeof(anzruns),1,f) != 1) ok=0;
+		if (fwrite(runs,sizeof(int32_t),anzruns,f) != (size_t)anzruns) ok=0;
+	}
+	delete[] runs;
+	
+	if (fclose(f) != 0) ok=0;
+	if (ok <= 0) remove(afn);
+	
+	return ok;
 }
 
-NTYP Complex::norm(void) {
-	return sqrt(re*re+im*im);
+// expected size of a level's bitmap, before it is allocated
+void printfootprint(CmTask& task,const int64_t abytes) {
+	double mb=abytes; mb /= (1 << 20);
+	if ( (_MEMLIMIT > 0) && (abytes > _MEMLIMIT) ) {
+		cmprintf(task,"[bitmap %.0lf MB, partly file-backed] ",mb);
+	} else {
+		cmprintf(task,"[bitmap %.0lf MB] ",mb);
+	}
 }
 
-NTYP Complex::normQ(void) {
-	return (re*re+im*im);
-}
+// struct ArrayByteManager
 
-Complex& Complex::operator=(const Complex& c) {
-	if (this != &c) {
-		re=c.re;
-		im=c.im;
-	}
-	
-	return *this;
+ArrayDDByteManager::ArrayDDByteManager() {
+	current=NULL;
+	allocatedIdx=0;
+	freeFromIdx=-1;
+	anzptr=anzallocated=0;
+	bytesallocated=0;
+	out=NULL;
+	double d=CHUNKSIZE; d /= sizeof(DDBYTE);
+	allocatePerBlock=(int)floor(d);
 }
 
-bool operator!=(const Complex a, const Complex b) {
-    return ( (a.re != b.re) || (a.im != b.im) );
+void ArrayDDByteManager::FreeAll(void) {
+	for(int32_t i=0;i<anzallocated;i++) {
+		#ifdef _MMAPAVAILABLE
+		if (mapped[i]>0) {
+			munmap(ptr[i],(size_t)allocatePerBlock*sizeof(DDBYTE));
+			continue;
+		}
+		#endif
+		delete[] ptr[i];
+		blocksinram.fetch_sub((int64_t)allocatePerBlock*sizeof(DDBYTE));
+	}
+	current=NULL;
+	anzptr=anzallocated=0;
 }
 
-Complex operator+(const Complex& a, const Complex& b) {
-    Complex ret(a.re+b.re, a.im+b.im);
-    return ret;
+// all memory handed out is invalid, the blocks are kept
+// and handed out again
+void ArrayDDByteManager::ReleaseAll(void) {
+	current=NULL;
+	anzptr=0;
 }
 
-Complex operator-(const Complex& a, const Complex& b) {
-    Complex ret(a.re-b.re, a.im-b.im);
-    return ret;
+// a block backed by an already deleted file in the current
+// directory: the OS writes cold pages there instead of keeping
+// them in RAM. NULL if not possible
+PDDBYTE getMappedBlock(const int64_t abytes) {
+	#ifdef _MMAPAVAILABLE
+	char fn[]="tsapredictor.map.XXXXXX";
+	int fd=mkstemp(fn);
+	if (fd < 0) return NULL;
+	unlink(fn);
+	if (ftruncate(fd,(off_t)abytes) != 0) {
+		close(fd);
+		return NULL;
+	}
+	void* p=mmap(NULL,(size_t)abytes,PROT_READ | PROT_WRITE,MAP_SHARED,fd,0);
+	close(fd);
+	if (p == MAP_FAILED) return NULL;
+	
+	return (PDDBYTE)p;
+	#else
+	return NULL;
+	#endif
 }
 
-// Polynom
-
-void Polynom::setCoeff(const int32_t aidx,const NTYP ar) {
-	setCoeff(aidx,Complex(ar,0.0));
+ArrayDDByteManager::~ArrayDDByteManager() {
+	FreeAll();
 }
 
-void Polynom::setCoeff(const int32_t aidx,const Complex ac) {
-	coeff[aidx]=ac;
-	if (coeff[aidx].normQ() < COEFFZEROLIMIT) coeffnull[aidx]=1;
-	else {
-		coeffnull[aidx]=0;
-		if (aidx > grad) grad=aidx;
+PDDBYTE ArrayDDByteManager::getMemory(const int32_t aanz) {
+	if (anzptr >= (MAXPTR-8)) {
+		LOGMSG("ArrayDDByteManager:: Zu wenig Speicher\n");
+		fail();
+	}
+	if (
+		(!current) ||
+		((freeFromIdx + aanz + 2) >= allocatedIdx)
+	) {
+		int64_t blockbytes=(int64_t)allocatePerBlock*sizeof(DDBYTE);
+		if (anzptr < anzallocated) {
+			// a block kept by ReleaseAll
+			current=ptr[anzptr];
+			anzptr++;
+		} else if (
+			(_MEMLIMIT > 0) &&
+			( (blocksinram.load()+blockbytes) > _MEMLIMIT)
+		) {
+			// m: file-backed block
+			if (out) out->append("m"); else printf("m");
+			ptr[anzptr]=current=getMappedBlock(blockbytes);
+			mapped[anzptr]=1;
+			anzptr++;
+			anzallocated=anzptr;
+			bytesallocated += blockbytes;
+			if (!current) {
+				LOGMSG("Memory-Fehler. ArrayByteManager/mmap.\n");
+				fail();
+			}
+		} else {
+			if (out) out->append("x"); else printf("x");
+			ptr[anzptr]=current=new DDBYTE[allocatePerBlock];
+			mapped[anzptr]=0;
+			anzptr++;
+			anzallocated=anzptr;
+			if (!current) {
+				LOGMSG("Memory-Fehler. ArrayByteManager.\n");
+				fail();
+			}
+			blocksinram.fetch_add(blockbytes);
+			bytesallocated += blockbytes;
+		}
+		freeFromIdx=0;
+		allocatedIdx=allocatePerBlock;
 	}
+	
+	PDDBYTE p=&current[freeFromIdx];
+	freeFromIdx += aanz;
+	return p;
 }
 
-void Polynom::clearCoeff(void) {
-	for(int32_t i=0;i<MAXDEGREE;i++) {
-		coeffnull[i]=1;
-		coeff[i]=Complex(0.0,0.0);
+char* upper(char* s) {
+	if (!s) return NULL;
+	for(int32_t i=(strlen(s)-1);i>=0;i--) {
+		if ((s[i]>='a')&&(s[i]<='z')) s[i]=s[i]-'a'+'A';
 	}
-	grad=0;
+
+	return s;
 }
 
-void Polynom::output(FILE* f) {
-	fprintf(f,"p(z)=");
-	int32_t erster=1;
-	for(int32_t i=grad;i>=0;i--) {
-		if (coeffnull[i]==0) {
-			if (erster) erster=0; else fprintf(f,"+");
-			fprintf(f,"(");
-			coeff[i].output(f);
-			if (i>1) fprintf(f,")*z^%i",i);
-			else if (i==1) fprintf(f,")*z");
-			else fprintf(f,")");
+int newton(
+	Polynom& polyf,
+	Polynom& polyabl,
+	const Complex astart,
+	Complex& erg) 
+{
+	Complex z=astart,f,fabl,zletzt,d;
+	
+	for(int32_t i=1;i<MAXIT;i++) {
+		zletzt=z;
+		// z(n+1)=zn-f(zn) / f'(zn);
+		polyf.eval_arg_f(z,f);
+		polyabl.eval_arg_f(z,fabl);
+		z = z - f / fabl;
+		d = z-zletzt;
+		if (d.normQ() < ZEROEPSILON) {
+			erg=z;
+			return i;
+		}
+	}
+	
+	return 0;
+}
+
+int getNullstellenIdx(const Complex aw,const int32_t ait) {
+	for(int32_t i=0;i<nbr_of_cp;i++) {
+		Complex d=zero[i].attractor- aw;
+		if (d.normQ() < ZEROEPSILON) {
+			return i;
+		}
+	}
+	if (nbr_of_cp > (MAXZEROS-8)) {
+		LOGMSG("Error. Too many roots.\n");
+		fail();
+	}
+	
+	zero[nbr_of_cp].clear();
+	zero[nbr_of_cp].attractor=aw;
+	nbr_of_cp++;
+
+	return (nbr_of_cp-1);
+}
+
+int getLagrange(Polynom& f) {
+	// i.e. Douady
+	double res=1.0;
+	for(int32_t i=0;i<=f.grad;i++) {
+		res += fkt.coeff[i].norm();
+	}
+	res /= fkt.coeff[fkt.grad].norm();
+	int expo=(int)ceil(log(ceil(res))/log(2.0));
+	return (1 << expo);
+}
+
+void ableitenFA(Polynom& infkt,Polynom& ergabl) {
+	ergabl.clearCoeff();
+	
+	for(int32_t i=1;i<=infkt.grad;i++) {
+		if (infkt.coeffnull[i]==0) {
+			ergabl.setCoeff(
+				i-1,
+				Complex(i,0)*infkt.coeff[i]
+			);
+		}
+	}
+}
+
+// f^p(z) and the derivative of f^p at z
+void orbitpower(Polynom& polyabl,const Complex az,const int32_t p,Complex& fp,Complex& dfp) {
+	fp=az;
+	dfp=Complex(1,0);
+	for(int32_t i=0;i<p;i++) {
+		Complex tmp,der;
+		polyabl.eval_arg_f(fp,der);
+		dfp = dfp*der;
+		fkt.eval_arg_f(fp,tmp);
+		fp=tmp;
+	}
+}
+
+// Newton on f^p(z)-z started at astart. Returns the minimal period
+// of the periodic point erg, 0 if Newton does not converge
+int32_t refinecycle(Polynom& polyabl,const Complex astart,const int32_t p,Complex& erg) {
+	Complex z=astart,fp,dfp;
+	int32_t polish=-1;
+	
+	for(int32_t i=0;i<64;i++) {
+		orbitpower(polyabl,z,p,fp,dfp);
+		Complex g=fp-z,dg=dfp-Complex(1,0);
+		if (dg.normQ() <= 0.0) return 0;
+		Complex d=g/dg;
+		z=z-d;
+		if (polish > 0) {
+			polish--;
+		} else if (polish==0) {
+			break;
+		} else if (d.normQ() < ZEROEPSILON) {
+			// 2 further steps to NTYP precision
+			polish=1;
+		}
+	}
+	if (polish != 0) return 0;
+	
+	orbitpower(polyabl,z,p,fp,dfp);
+	Complex d=fp-z;
+	if (d.normQ() >= ZEROEPSILON) return 0;
+	
+	erg=z;
+	// smallest period
+	for(int32_t q=1;q<p;q++) {
+		if ((p % q) != 0) continue;
+		orbitpower(polyabl,z,q,fp,dfp);
+		d=fp-z;
+		if (d.normQ() < ZEROEPSILON) {
+			// better conditioned on f^q(z)-z
+			return refinecycle(polyabl,z,q,erg);
+		}
+	}
+	
+	return p;
+}
+
+// attracting cycle of period p through az and the orbit point
+// at contracts towards it for some periods
+int cycleattracts(Polynom& polyabl,const Complex az,const int32_t p,const Complex at) {
+	Complex fp,dfp;
+	orbitpower(polyabl,az,p,fp,dfp);
+	if (dfp.norm() >= 1.0) return 0;
+	
+	Complex w=at,d=w-az;
+	NTYP dq=d.normQ();
+	for(int32_t k=0;k<4;k++) {
+		orbitpower(polyabl,w,p,fp,dfp);
+		w=fp;
+		d=w-az;
+		if (d.normQ() >= dq) return 0;
+		dq=d.normQ();
+	}
+	
+	return 1;
+}
+
+// CONTINUE: Newton on the cycle acont of the previous point, then
+// the critical orbit from az0 followed until it comes close to the
+// refined periodic point. Returns its period (erg the point, an the
+// step it was reached at) or 0 if the period changed, the cycle is
+// no longer attracting or the orbit escapes or does not reach it
+int32_t continuecycle(Polynom& polyabl,const Complex az0,ContinuationCycle& acont,Complex& erg,int32_t& an) {
+	Complex z;
+	int32_t q=refinecycle(polyabl,acont.pp,acont.period,z);
+	if (q != acont.period) return 0;
+	Complex fp,dfp;
+	orbitpower(polyabl,z,q,fp,dfp);
+	if (dfp.norm() >= 1.0) return 0;
+	
+	double escapeQ=COMPLETE1*COMPLETE1;
+	// within a period of reaching the cycle the orbit passes z
+	Complex w=az0;
+	for(int32_t n=1;n<MAXIT;n++) {
+		Complex tmp;
+		fkt.eval_arg_f(w,tmp);
+		w=tmp;
+		if (w.normQ() > escapeQ) return 0;
+		Complex d=w-z;
+		if (d.normQ() < CYCLECANDIDATEQ) {
+			if (cycleattracts(polyabl,z,q,w) <= 0) return 0;
+			erg=z;
+			an=n;
+			return q;
+		}
+	}
+	
+	return 0;
+}
+
+int ps_construct_critical_orbits(void) {
+	double escapeQ=COMPLETE1*COMPLETE1;
+	int cyclenumber=1;
+	int returnvalue=0;
+
+	Polynom polyabl;
+	ableitenFA(fkt,polyabl);
+	
+	for(int32_t cp=0;cp<nbr_of_cp;cp++) {
+		Complex z0=zero[cp].attractor;
+		
+		// Brent: the tortoise waits at step power-1 for the hare
+		// to return within lam <= power steps. Only the two
+		// points are kept, not the orbit
+		Complex tortoise=z0,hare=z0,zcycle;
+		int32_t power=1,lam=0,n=0,period=0,esc=0;
+		int32_t cap=MAXIT,nreject=-1;
+		// closest return refined without success
+		NTYP dreject=-1.0;
+		if (z0.normQ() > escapeQ) esc=1;
+		// CONTINUE: the cycle of the previous point refined and
+		// reached by the orbit, else the full search
+		if ( (esc<=0) && (cp < anzcont) && (contcycle[cp].period > 0) ) {
+			period=continuecycle(polyabl,z0,contcycle[cp],zcycle,n);
+			if (period > 0) zero[cp].continuelevel=contcycle[cp].level;
+			else n=0;
+		}
+		while ( (esc<=0) && (period <= 0) && (n < cap) ) {
+			Complex tmp;
+			fkt.eval_arg_f(hare,tmp);
+			hare=tmp;
+			n++;
+			lam++;
+			if (hare.normQ() > escapeQ) {
+				esc=1;
+				break;
+			}
+			
+			Complex d=hare-tortoise;
+			NTYP dq=d.normQ();
+			if (dq < ZEROEPSILON) {
+				// returned (e.g. preperiodic to a repelling cycle)
+				if ((period=refinecycle(polyabl,hare,lam,zcycle)) <= 0) {
+					zcycle=hare;
+					period=lam;
+				}
+				break;
+			}
+			if (
+				(dq < CYCLECANDIDATEQ) &&
+				( (dreject < 0.0) || (dq < (0.0625*dreject)) )
+			) {
+				// convergence acceleration: close to an attracting cycle
+				// of period lam the orbit needs not be followed further
+				Complex test;
+				int32_t q=refinecycle(polyabl,hare,lam,test);
+				if ( (q > 0) && (cycleattracts(polyabl,test,q,hare) > 0) ) {
+					zcycle=test;
+					period=q;
+					break;
+				}
+				dreject=dq;
+				nreject=n;
+			}
+			
+			if (lam == power) {
+				tortoise=hare;
+				power *= 2;
+				lam=0;
+			}
+			// adaptive cap: further iterations as long as the orbit
+			// still approaches a cycle
+			if (
+				(n >= cap) && (cap < (MAXITFACTOR*MAXIT)) &&
+				(nreject > (n-MAXIT))
+			) {
+				cap += MAXIT;
+			}
+		} // n
+		
+		if (esc>0) {
+			zero[cp].clear();
+			continue;
+		}
+		
+		// not periodic
+		if (period <= 0) {
+			zero[cp].clear();
+			continue;
+		}
+		
+		// periodic orbit: zcycle is the orbit point n
+		
+		// has an earlier analyzed critical point already
+		// found that orbit ?
+		// then discard this one here
+		int found=0;
+		for(int32_t cpprev=0;cpprev<cp;cpprev++) {
+			for(int32_t k=0;k<zero[cpprev].cyclelen;k++) {
+				Complex d=zero[cpprev].cycle[k].pp - zcycle;
+				if (d.normQ() < ZEROEPSILON) {
+					found=1;
+					break;
+				}
+			}
+			if (found>0) break;
+		} // cpprev
+		
+		if (found>0) {
+			// previously found cycle
+			// this cp is marked as uninteresting
+			zero[cp].clear();
+			continue;
+		}
+		
+		// the cycle starts with the point the orbit visits
+		// at a step of MAXIT modulo period
+		int32_t shift=(MAXIT-n) % period;
+		if (shift < 0) shift += period;
+		Complex zn=zcycle;
+		for(int32_t i=0;i<shift;i++) {
+			Complex tmp;
+			fkt.eval_arg_f(zn,tmp);
+			zn=tmp;
+		}
+		
+		zero[cp].cyclelen=period;
+		zero[cp].cycle=new PeriodicPoint[zero[cp].cyclelen + 8];
+		Complex multiplier=Complex(1,0);
+		for(int32_t i=0;i<period;i++) {
+			zero[cp].cycle[i].pp=zn;
+			Complex der,tmp;
+			polyabl.eval_arg_f(zn,der);
+			multiplier = multiplier*der;
+			fkt.eval_arg_f(zn,tmp);
+			zn=tmp;
+		}
+		zero[cp].multiplier=multiplier.norm();
+		zero[cp].cyclenumber=cyclenumber;
+		cyclenumber++;
+		if (zero[cp].multiplier > 1.00001) {
+			// a little buffer
+			// repelling
+			zero[cp].cyclelen=0;
+			delete[] zero[cp].cycle;
+			zero[cp].cycle=NULL;
+			zero[cp].interiorfound=0;
+		}
+		
+		returnvalue++;
+		
+	} // cp
+	
+	return returnvalue;
+}
+
+// z^N+A*z+c (all built-in FUNC): f'(z)=N*z^(N-1)+A, so the critical
+// points are the (N-1)-th roots of -A/N, each refined by Newton to NTYP
+// precision. Returns 0 if fkt is not of that form
+int cp_closed_form(Polynom& fktforcp,Polynom& ablforcp) {
+	const int32_t n=fkt.grad;
+	if (n < 2) return 0;
+	for(int32_t i=2;i<n;i++) {
+		if (fkt.coeffnull[i]==0) return 0;
+	}
+	
+	if (fkt.coeffnull[1]) {
+		// z^N+c: a single critical point of multiplicity N-1
+		getNullstellenIdx(Complex(0,0),1);
+		return 1;
+	}
+	
+	Complex w=fkt.coeff[1] / (Complex(n,0)*fkt.coeff[n]);
+	double r=pow(sqrt((double)(w.re*w.re+w.im*w.im)),1.0/(n-1));
+	double phi=atan2(-(double)w.im,-(double)w.re);
+	for(int32_t k=0;k<(n-1);k++) {
+		double ang=(phi+2.0*M_PI*k)/(n-1);
+		Complex start(r*cos(ang),r*sin(ang)),z;
+		if (newton(fktforcp,ablforcp,start,z) <= 0) z=start;
+		getNullstellenIdx(z,1);
+	}
+
+	return 1;
+}
+
+// Aberth-Ehrlich: all zeros z[0..p.grad-1] of p at once
+// returns 0 if not converged
+int cp_aberth(Polynom& p,Polynom& pabl,Complex* z) {
+	const int32_t m=p.grad;
+	if (m <= 0) return 0;
+	
+	// all zeros lie in the Cauchy radius
+	double r=0.0;
+	for(int32_t i=0;i<m;i++) {
+		double q=(double)p.coeff[i].norm() / (double)p.coeff[m].norm();
+		if (q > r) r=q;
+	}
+	r += 1.0;
+	for(int32_t k=0;k<m;k++) {
+		// off the symmetry axes of the built-in families
+		double ang=2.0*M_PI*k/m+0.4;
+		z[k]=Complex(r*cos(ang),r*sin(ang));
+	}
+	
+	for(int32_t it=0;it<MAXIT;it++) {
+		NTYP dmax=0.0;
+		for(int32_t k=0;k<m;k++) {
+			Complex f,fabl;
+			p.eval_arg_f(z[k],f);
+			if (f.normQ() <= 0.0) continue;
+			pabl.eval_arg_f(z[k],fabl);
+			Complex sum(0,0);
+			for(int32_t j=0;j<m;j++) {
+				if (j==k) continue;
+				Complex d=z[k]-z[j];
+				if (d.normQ() > 0.0) sum=sum+Complex(1,0)/d;
+			}
+			Complex ratio=f/fabl;
+			Complex w=ratio / (Complex(1,0)-ratio*sum);
+			z[k]=z[k]-w;
+			if (w.normQ() > dmax) dmax=w.normQ();
+		}
+		if (dmax < ZEROEPSILON) return 1;
+	}
+	
+	return 0;
+}
+
+// searches all border pixels of the underlying image in the 3 times Lagrange estimate
+// (modified after Hubbard, Schleicher, Sutherland. How to find all roots of complex polynomials, 2001)
+// the Newton runs are done in blocks on THREADS threads, the zeros are
+// taken in border order so the result does not depend on the threads
+void cp_border_scan(Polynom& fktforcp,Polynom& ablforcp) {
+	double ESCAPEQ=COMPLETE1*COMPLETE1;
+
+	const int32_t LEN=1024;
+	// 3 times ESCAPER: far away from the roots, so dynamics
+	// here are tame: cvhannels to infinity as in paper byy Schleicher
+	// about the universal set of Newton starting points
+	int32_t SCRRE0=-3*ESCAPEQ;
+	int32_t SCRIM0=-3*ESCAPEQ;
+	int32_t SCRIM1= 3*ESCAPEQ;
+	NTYP sk=SCRIM1-SCRIM0; sk /= LEN;
+	
+	// left, upper, right, lower border
+	const int32_t ANZSTART=4*(LEN-1);
+	const int32_t BLOCK=256;
+	Complex* found=new Complex[BLOCK];
+	int32_t* it=new int32_t[BLOCK];
+	
+	auto startpoint=[&](const int32_t i) {
+		int32_t side=i / (LEN-1),k=i % (LEN-1),x,y;
+		switch (side) {
+			case 0: x=0; y=k; break;
+			case 1: x=k; y=LEN-1; break;
+			case 2: x=LEN-1; y=LEN-1-k; break;
+			default: x=LEN-1-k; y=0; break;
+		}
+		return Complex(x*sk + SCRRE0,y*sk + SCRIM0);
+	};
+	
+	for(int32_t b0=0;b0<ANZSTART;b0+=BLOCK) {
+		int32_t b1=b0+BLOCK-1;
+		if (b1 >= ANZSTART) b1=ANZSTART-1;
+		auto runnewton=[&](const int32_t i) {
+			it[i-b0]=newton(fktforcp,ablforcp,startpoint(i),found[i-b0]);
+		};
+		parallel_rows(THREADS,b0,b1,runnewton);
+		
+		for(int32_t i=b0;i<=b1;i++) {
+			if (it[i-b0] > 0) {
+				getNullstellenIdx(found[i-b0],it[i-b0]);
+				if (nbr_of_cp >= fktforcp.grad) break;
+			}
+		}
+		if (nbr_of_cp >= fktforcp.grad) break;
+	}
+	
+	delete[] found;
+	delete[] it;
+}
+
+// CONTINUE: every critical point of the previous SWEEP point refined
+// by Newton. Returns 0 if one does not converge or two coincide
+int cp_continued(Polynom& fktforcp,Polynom& ablforcp) {
+	for(int32_t k=0;k<anzcont;k++) {
+		Complex z;
+		if (newton(fktforcp,ablforcp,contcycle[k].attractor,z) <= 0) return 0;
+		getNullstellenIdx(z,1);
+	}
+	
+	return (nbr_of_cp == anzcont);
+}
+
+// angle counter-clockwise from the negative real axis, then modulus
+int cp_before(const Complex& a,const Complex& b) {
+	auto angle=[](const Complex& z) {
+		double t=atan2(-(double)z.im,-(double)z.re);
+		if (t < 0.0) t += 2.0*M_PI;
+		// on the negative real axis up to rounding
+		if (t > (2.0*M_PI-1E-9)) t=0.0;
+		return t;
+	};
+	double ta=angle(a),tb=angle(b);
+	if (fabs(ta-tb) > 1E-9) return (ta < tb);
+	
+	return (a.re*a.re+a.im*a.im) < (b.re*b.re+b.im*b.im);
+}
+
+void ps_find_critical_points(void) {
+	// fkt: iterated function
+	// cp: zeros of 1st order derivative
+	Polynom fktforcp,ablforcp;
+	ableitenFA(fkt,fktforcp);
+	ableitenFA(fktforcp,ablforcp);
+	
+	nbr_of_cp=0;
+	int32_t ok=0;
+	if (anzcont > 0) {
+		// CONTINUE: Newton from the previous point's critical points
+		ok=cp_continued(fktforcp,ablforcp);
+		if (ok <= 0) nbr_of_cp=0;
+	}
+	if ( (ok <= 0) && (_CRITICAL==CRITICAL_AUTO) ) {
+		ok=cp_closed_form(fktforcp,ablforcp);
+	}
+	if ( (ok <= 0) && (_CRITICAL != CRITICAL_SCAN) ) {
+		Complex z[MAXDEGREE];
+		if (cp_aberth(fktforcp,ablforcp,z) > 0) {
+			for(int32_t k=0;k<fktforcp.grad;k++) {
+				Complex zn;
+				if (newton(fktforcp,ablforcp,z[k],zn) <= 0) zn=z[k];
+				getNullstellenIdx(zn,1);
+			}
+			ok=1;
+		}
+	}
+	if (ok <= 0) {
+		nbr_of_cp=0;
+		cp_border_scan(fktforcp,ablforcp);
+	}
+	
+	// in a fixed order independent of the method (cycle numbers)
+	for(int32_t i=1;i<nbr_of_cp;i++) {
+		Complex a=zero[i].attractor;
+		int32_t j=i-1;
+		for(;(j >= 0) && cp_before(a,zero[j].attractor);j--) {
+			zero[j+1].attractor=zero[j].attractor;
+		}
+		zero[j+1].attractor=a;
+	}
+}
+
+// Complex
+
+void Complex::output(FILE* f) {
+	fprintf(f,"%.20lg%+.20lgi",(double)re,(double)im);
+}
+
+Complex Complex::operator*(const Complex a) {
+    Complex ret(a.re*re-a.im*im, a.im*re+a.re*im);
+
+    return ret;
+}
+
+Complex::Complex(const NTYP r, const NTYP i) {
+	re=r;
+	im=i;
+}
+
+Complex operator/(const Complex& a,const Complex& b) {
+    const NTYP n2=b.re*b.re+b.im*b.im;
+    Complex ret(
+		(a.re*b.re+a.im*b.im)/n2,
+		(a.im*b.re-a.re*b.im) / n2
+    );
+
+    return ret;
+}
+
+NTYP Complex::norm(void) {
+	return sqrt(re*re+im*im);
+}
+
+NTYP Complex::normQ(void) {
+	return (re*re+im*im);
+}
+
+Complex& Complex::operator=(const Complex& c) {
+	if (this != &c) {
+		re=c.re;
+		im=c.im;
+	}
+	
+	return *this;
+}
+
+bool operator!=(const Complex a, const Complex b) {
+    return ( (a.re != b.re) || (a.im != b.im) );
+}
+
+Complex operator+(const Complex& a, const Complex& b) {
+    Complex ret(a.re+b.re, a.im+b.im);
+    return ret;
+}
+
+Complex operator-(const Complex& a, const Complex& b) {
+    Complex ret(a.re-b.re, a.im-b.im);
+    return ret;
+}
+
+// Polynom
+
+void Polynom::setCoeff(const int32_t aidx,const NTYP ar) {
+	setCoeff(aidx,Complex(ar,0.0));
+}
+
+void Polynom::setCoeff(const int32_t aidx,const Complex ac) {
+	coeff[aidx]=ac;
+	if (coeff[aidx].normQ() < COEFFZEROLIMIT) coeffnull[aidx]=1;
+	else {
+		coeffnull[aidx]=0;
+		if (aidx > grad) grad=aidx;
+	}
+}
+
+void Polynom::clearCoeff(void) {
+	for(int32_t i=0;i<MAXDEGREE;i++) {
+		coeffnull[i]=1;
+		coeff[i]=Complex(0.0,0.0);
+	}
+	grad=0;
+}
+
+void Polynom::output(FILE* f) {
+	fprintf(f,"p(z)=");
+	int32_t erster=1;
+	for(int32_t i=grad;i>=0;i--) {
+		if (coeffnull[i]==0) {
+			if (erster) erster=0; else fprintf(f,"+");
+			fprintf(f,"(");
+			coeff[i].output(f);
+			if (i>1) fprintf(f,")*z^%i",i);
+			else if (i==1) fprintf(f,")*z");
+			else fprintf(f,")");
+		}
+	}
+	fprintf(f,"\n");
+}
+
+void Polynom::eval_arg_f(const Complex az,Complex& erg) {
+	erg=coeff[grad];
+	
+	for(int32_t i=grad;i>0;i--) {
+		erg = erg*az;
+		erg = erg + coeff[i-1];
+	}
+}
+
+Polynom::Polynom() {
+	grad=0;
+	clearCoeff();
+}
+
+void Polynom::setCoeff(const int32_t aidx,const NTYP ar,const NTYP ai) {
+	setCoeff(aidx,Complex(ar,ai));
+}
+
+// analyzes levels alevel0..alevel1 of one cycle in number type T
+template<class T>
+int cm_local_T(Root& onecycle,const DDBYTE startwith,CmTask& task,const int32_t alevel0,const int32_t alevel1) {
+	typedef NumCore<T> NC;
+	// a bounding box for ALL cyclic points
+	// small rectangles around every cyclic point
+	ScreenRect enclosementall;
+	CmGrid<T> grid;
+	PlaneRectT<T>& local=grid.local;
+	T& scaleRangePerPixel=grid.scaleRangePerPixel;
+	T& scalePixelPerRange=grid.scalePixelPerRange;
+	
+	// the blocks are reused from level to level, and with
+	// task.rows/tiles from call to call
+	ArrayDDByteManager ownrows;
+	ArrayDDByteManager& mgr=(task.rows ? *task.rows : ownrows);
+	mgr.out=task.out;
+	PDDBYTE *ispotwY=NULL;
+	// BITMAP=TILES: the bitmap is kept in tiles instead of ispotwY
+	const int8_t tiled=(_BITMAP==BITMAP_TILES);
+	TiledBitmap owntiles;
+	TiledBitmap& tiles=(task.tiles ? *task.tiles : owntiles);
+	tiles.clearTiles();
+	// CACHE: levels already analyzed
+	char cachekey[256];
+	int32_t encw=_ENCLOSEMENTWIDTH;
+	cyclecachekey(onecycle,startwith,encw,cachekey);
+	
+	#define SET32_MY(MM,YY,FF32) \
+	{\
+		if (\
+			( (MM) >= mem0 ) &&\
+			( (MM) <= mem1 ) &&\
+			( (YY) >= enclosementall.y0 ) &&\
+			( (YY) <= enclosementall.y1 ) \
+		) {\
+			if (tiled>0) {\
+				PDDBYTE pw32=tiles.getWord(MM,YY);\
+				if (!pw32) {\
+					LOGMSG4("Error/mil. Set32 tile %i,%i,%i\n",MM,YY,FF32);\
+					fail();\
+				}\
+				*pw32=FF32;\
+			} else if (ispotwY[ (YY)-enclosementall.y0 ]) {\
+				ispotwY[ (YY)-enclosementall.y0 ][MM-mem0] = FF32;\
+			} else {\
+				LOGMSG4("Error/mil. Set32 %i,%i,%i\n",MM,YY,FF32);\
+				fail();\
+			}\
+		} else {\
+			LOGMSG4("Error. Set32 %i,%i,%i\n",MM,YY,FF32);\
+			fail();\
+		}\
+	}
+	
+	// setting bits to POTW while other threads read the bitmap
+	#define OR32_MY(MM,YY,FF32) \
+	{\
+		PDDBYTE pw32=NULL;\
+		if (\
+			( (MM) >= mem0 ) &&\
+			( (MM) <= mem1 ) &&\
+			( (YY) >= enclosementall.y0 ) &&\
+			( (YY) <= enclosementall.y1 ) \
+		) {\
+			if (tiled>0) pw32=tiles.getWord(MM,YY);\
+			else if (ispotwY[ (YY)-enclosementall.y0 ]) pw32=&ispotwY[ (YY)-enclosementall.y0 ][MM-mem0];\
+		}\
+		if (pw32) {\
+			ATOMIC_OR32(pw32,FF32);\
+		} else {\
+			LOGMSG4("Error. Or32 %i,%i,%i\n",MM,YY,FF32);\
+			fail();\
+		}\
+	}
+	
+	#define GET32_MY(MM,YY,ERG32) \
+	{\
+		ERG32=ALL32POTW;\
+		if (\
+			( (YY) >= enclosementall.y0) &&\
+			( (YY) <= enclosementall.y1)\
+		) {\
+			if (tiled>0) {\
+				if ( ( (MM) >= mem0) && ( (MM) <= mem1) ) {\
+					PDDBYTE pw32=tiles.getWord(MM,YY);\
+					if (pw32) ERG32=ATOMIC_LOAD32(pw32);\
+				}\
+			} else if ( (ispotwY[ (YY)-enclosementall.y0 ]) &&\
+				( (MM) >= mem0) &&\
+				( (MM) <= mem1) \
+			) {\
+				ERG32=ATOMIC_LOAD32(&ispotwY[ (YY)-enclosementall.y0][ (MM)-mem0 ]);\
+			}\
+		}\
+	}
+
+	// YY is ABSOLUTE screen coordinates
+	// MM is ABSOLUTE mem position, i.e. *32 is pixel coordinate
+	#define CELLCOLOR_XY(XX,YY,ERG) \
+	{\
+		ERG=SQUARE_POTW;\
+		if (\
+			( (XX) >= enclosementall.x0) &&\
+			( (XX) <= enclosementall.x1) &&\
+			( (YY) >= enclosementall.y0) &&\
+			( (YY) <= enclosementall.y1) \
+		) {\
+			int bmem=(XX) >> SHIFTPERDDBYTE;\
+			DDBYTE f32;\
+			GET32_MY(bmem,YY,f32);\
+			int bbit=(XX) % (1 << SHIFTPERDDBYTE);\
+			ERG=(f32 >> bbit) & 0b1;\
+		}\
+	}
+	
+	// does screen rectangle SCR contain a POTW pixel
+	// same result as CELLCOLOR_XY for every pixel, but pixels outside
+	// enclosementall or in rows without memory are POTW in one step
+	// and the rows are tested a word at a time, first and last word
+	// masked to the pixels in SCR. With tiles SCR is tested tile by
+	// tile, every tile looked up once and its rows read as 64-bit
+	// TILEROWs, a missing tile is POTW.
+	// The pixels of the rows read are added to hitpixels (METRICS)
+	#define RECT_HITS_POTW(SCR,ERG) \
+	{\
+		ERG=0;\
+		if ( ((SCR).x0 > (SCR).x1) || ((SCR).y0 > (SCR).y1) ) {\
+			/* empty */\
+		} else if (\
+			( (SCR).x0 < enclosementall.x0) ||\
+			( (SCR).x1 > enclosementall.x1) ||\
+			( (SCR).y0 < enclosementall.y0) ||\
+			( (SCR).y1 > enclosementall.y1) \
+		) {\
+			ERG=1;\
+		} else if (tiled>0) {\
+			/* tile by tile, a missing tile is POTW, the rows of a */\
+			/* tile 64 pixels at a time */\
+			for(int32_t ty=((SCR).y0 >> TILESHIFTY);(ty<=((SCR).y1 >> TILESHIFTY)) && (ERG<=0);ty++) {\
+				int32_t r0=(ty << TILESHIFTY),r1=r0+TILEROWS-1;\
+				if (r0 < (SCR).y0) r0=(SCR).y0;\
+				if (r1 > (SCR).y1) r1=(SCR).y1;\
+				for(int32_t tx=((SCR).x0 >> TILESHIFTX);tx<=((SCR).x1 >> TILESHIFTX);tx++) {\
+					int32_t px0=(tx << TILESHIFTX),px1=px0+TILEPIXELS-1;\
+					if (px0 < (SCR).x0) px0=(SCR).x0;\
+					if (px1 > (SCR).x1) px1=(SCR).x1;\
+					hitpixels += (int64_t)(px1-px0+1)*(r1-r0+1);\
+					int32_t ct=tiles.findTile(tx,ty);\
+					if (ct < 0) {\
+						ERG=1;\
+						break;\
+					}\
+					TILEROW tmask=\
+						(ALL64POTW << (px0 & (TILEPIXELS-1))) &\
+						(ALL64POTW >> ( (TILEPIXELS-1) - (px1 & (TILEPIXELS-1)) ));\
+					PTILEROW trows=(PTILEROW)&tiles.words[(int64_t)ct*TILEWORDS];\
+					for(int32_t r=r0;r<=r1;r++) {\
+						if (ATOMIC_LOAD64(&trows[r & (TILEROWS-1)]) & tmask) {\
+							ERG=1;\
+							break;\
+						}\
+					}\
+					if (ERG>0) break;\
+				}\
+			}\
+		} else {\
+			int32_t bm0=((SCR).x0 >> SHIFTPERDDBYTE)-mem0;\
+			int32_t bm1=((SCR).x1 >> SHIFTPERDDBYTE)-mem0;\
+			DDBYTE mask0=ALL32POTW << ( (SCR).x0 & ((1 << SHIFTPERDDBYTE)-1) );\
+			DDBYTE mask1=ALL32POTW >> ( ((1 << SHIFTPERDDBYTE)-1) - ( (SCR).x1 & ((1 << SHIFTPERDDBYTE)-1) ) );\
+			if (bm0 == bm1) {\
+				mask0 &= mask1;\
+				mask1=mask0;\
+			}\
+			for(int32_t by=(SCR).y0;by<=(SCR).y1;by++) {\
+				hitpixels += (SCR).x1-(SCR).x0+1;\
+				PDDBYTE brow=ispotwY[by-enclosementall.y0];\
+				if (\
+					(!brow) ||\
+					(ATOMIC_LOAD32(&brow[bm0]) & mask0) ||\
+					(ATOMIC_LOAD32(&brow[bm1]) & mask1)\
+				) {\
+					ERG=1;\
+					break;\
+				}\
+				for(int32_t bm=bm0+1;bm<bm1;bm++) {\
+					if (ATOMIC_LOAD32(&brow[bm]) != ALL32GRAY) {\
+						ERG=1;\
+						break;\
+					}\
+				}\
+				if (ERG>0) break;\
+			}\
+		}\
+	}
+	
+	// METRICS: counters of the level being analyzed, the threads of
+	// a sweep add theirs per word
+	const int8_t counting=(onecycle.metrics != NULL);
+	std::atomic<int64_t> ncells(0),nbbx(0),npixels(0),nexact(0);
+	int32_t npasses=0;
+	int64_t levelbytes0=0,levelfootprint=0;
+	double levelstart=0.0;
+	
+	// screen rectangles of the bounding boxes of the gray cells of
+	// word m in the row A.y0..A.y1. Bit b of the return value is set
+	// if cell b's bounding box lies in local and the complete square,
+	// only then scr[b] is valid
+	auto wordscreenrects=[&](const int32_t m,const DDBYTE ff,PlaneRectT<T>& A,ScreenRect* scr) {
+		DDBYTE inside=0;
+		uint32_t xcoord0=m << SHIFTPERDDBYTE;
+		
+		if (wordkernel(grid,A,xcoord0,~ff,scr,inside) > 0) {
+			if (counting>0) nbbx.fetch_add(wordkernelboxes(~ff),std::memory_order_relaxed);
+			return inside;
+		}
+		
+		if (counting>0) nbbx.fetch_add(__builtin_popcount(~ff),std::memory_order_relaxed);
+		for(int32_t bit=0;bit<32;bit++) {
+			if ( ((ff >> bit) & 0b1) == SQUARE_POTW) continue;
+			
+			int xc=xcoord0+bit;
+			A.x0=xc*scaleRangePerPixel + NC::COMPLETE0;
+			A.x1=A.x0+scaleRangePerPixel;
+			if (getScreenRectfA(grid,A,scr[bit]) > 0) {
+				inside |= ((DDBYTE)1 << bit);
+			}
+		}
+		
+		return inside;
+	};
+	
+	int32_t interiorpresentat=0;
+	onecycle.interiorfound=0;
+	int8_t* ywithgray=NULL;
+	
+	// METRICS: the counters of the level just analyzed are noted
+	auto notelevel=[&](const int32_t REFINEMENT,const int8_t asource) {
+		if ( (counting<=0) || (onecycle.anzmetrics >= MAXLEVELMETRICS) ) return;
+		
+		LevelMetrics& lm=onecycle.metrics[onecycle.anzmetrics];
+		onecycle.anzmetrics++;
+		lm.level=REFINEMENT;
+		lm.encw=encw;
+		lm.prec=levelprecision(REFINEMENT);
+		lm.source=asource;
+		lm.black=(interiorpresentat > 0);
+		lm.passes=npasses;
+		lm.cells=ncells.load();
+		lm.bbx=nbbx.load();
+		lm.pixels=npixels.load();
+		lm.exact=nexact.load();
+		lm.footprint=levelfootprint;
+		lm.bytes=mgr.bytesallocated+tiles.bytesallocated-levelbytes0;
+		lm.seconds=wallseconds()-levelstart;
+	};
+	
+	// INCREMENTAL: per cell the sequence number when it turned
+	// POTW, kept from one level to the next
+	uint32_t** rankY=NULL;
+	uint32_t rankmax=0;
+	int32_t ranky0=0,ranklenY=0,rankmem0=0,rankmem1=-1,ranklevel=0;
+	
+	// analyzes one level with enclosements of width encw,
+	// returns REFINEMENT if GRAY cells survive, 0 otherwise
+	auto analyzeencw=[&](const int32_t REFINEMENT) {
+		cmprintf(task,"\nchecking level %i ",REFINEMENT);
+		if (_ENCWAUTO > 0) cmprintf(task,"encw %i ",encw);
+		levelstart=wallseconds();
+		npasses=0;
+		ncells.store(0);
+		nbbx.store(0);
+		npixels.store(0);
+		nexact.store(0);
+		levelfootprint=0;
+		levelbytes0=mgr.bytesallocated+tiles.bytesallocated;
+		int64_t SCREENWIDTH=( (int64_t)1 << REFINEMENT);
+		int64_t MAXMEM=SCREENWIDTH >> SHIFTPERDDBYTE;
+		scaleRangePerPixel=(NC::COMPLETE1-NC::COMPLETE0)/(double)SCREENWIDTH;
+		scalePixelPerRange=(double)SCREENWIDTH/(NC::COMPLETE1-NC::COMPLETE0);
+		enclosementall.x0=enclosementall.y0=(int32_t)(SCREENWIDTH-1);
+		enclosementall.x1=enclosementall.y1=0;
+		for(int32_t k=0;k<onecycle.cyclelen;k++) {
+			int32_t xx=scrcoord_as_lowerleft((T)onecycle.cycle[k].pp.re,scalePixelPerRange);
+			int32_t yy=scrcoord_as_lowerleft((T)onecycle.cycle[k].pp.im,scalePixelPerRange);
+			ScreenRect scr;
+			scr.x0=xx-encw; 
+			scr.x1=xx+encw;
+			scr.y0=yy-encw;
+			scr.y1=yy+encw;
+
+			#define TRIM(WW) \
+			{\
+				if ( WW < 0) WW=0;\
+				else if (WW >= SCREENWIDTH) WW=SCREENWIDTH-1;\
+			}
+
+			TRIM(scr.x0)
+			TRIM(scr.x1)
+			TRIM(scr.y0)
+			TRIM(scr.y1)
+			
+			if (scr.x0 < enclosementall.x0) enclosementall.x0=scr.x0;
+			if (scr.x1 > enclosementall.x1) enclosementall.x1=scr.x1;
+			if (scr.y0 < enclosementall.y0) enclosementall.y0=scr.y0;
+			if (scr.y1 > enclosementall.y1) enclosementall.y1=scr.y1;
+			
+			onecycle.cycle[k].mem0=scr.x0 >> SHIFTPERDDBYTE;
+			onecycle.cycle[k].mem1=scr.x1 >> SHIFTPERDDBYTE;
+			if (onecycle.cycle[k].mem1 >= MAXMEM) {
+				LOGMSG("Implementation error. Maxmem reached\n");
+				fail();
+			}
+			onecycle.cycle[k].y0=scr.y0;
+			onecycle.cycle[k].y1=scr.y1;
+		}
+		
+		int32_t mem0=enclosementall.x0 >> SHIFTPERDDBYTE;
+		int32_t mem1=enclosementall.x1 >> SHIFTPERDDBYTE;
+		if (mem1 >= MAXMEM) {
+			LOGMSG("Implementation error. Maxmem/2 reached\n");
+			fail();
+		}
+		
+		// translate enclosementall into complex coordinates
+		local.x0=enclosementall.x0*scaleRangePerPixel + NC::COMPLETE0;
+		local.x1=(enclosementall.x1+1)*scaleRangePerPixel + NC::COMPLETE0;
+		local.y0=enclosementall.y0*scaleRangePerPixel + NC::COMPLETE0;
+		local.y1=(enclosementall.y1+1)*scaleRangePerPixel + NC::COMPLETE0;
+		grid.mixed=( (_MIXED > 0) && (levelprecision(REFINEMENT) != PRECISION_D) );
+		grid.localD.x0=(double)local.x0;
+		grid.localD.x1=(double)local.x1;
+		grid.localD.y0=(double)local.y0;
+		grid.localD.y1=(double)local.y1;
+		grid.scalePixelPerRangeD=(double)scalePixelPerRange;
+		grid.errorD=mixederror();
+		grid.nexact=(counting > 0 ? &nexact : NULL);
+		onecycle.ps_basinrect.x0=(NTYP)local.x0;
+		onecycle.ps_basinrect.x1=(NTYP)local.x1;
+		onecycle.ps_basinrect.y0=(NTYP)local.y0;
+		onecycle.ps_basinrect.y1=(NTYP)local.y1;
+		
+		const char* levelprec=precisionname[levelprecision(REFINEMENT)];
+		if ( 
+			(task.ckpt) && 
+			(task.ckpt->outcome[REFINEMENT] >= 0) &&
+			(task.ckpt->outcomeprec[REFINEMENT] == levelprecision(REFINEMENT))
+		) {
+			cmprintf(task,"from checkpoint");
+			interiorpresentat=(task.ckpt->outcome[REFINEMENT] > 0 ? REFINEMENT : 0);
+			notelevel(REFINEMENT,LEVELSOURCE_CHECKPOINT);
+			return interiorpresentat;
+		}
+		int8_t cached=rcache.lookup(cachekey,REFINEMENT,levelprec);
+		if (cached >= 0) {
+			cmprintf(task,"cached");
+			interiorpresentat=(cached > 0 ? REFINEMENT : 0);
+			notelevel(REFINEMENT,LEVELSOURCE_CACHE);
+			return interiorpresentat;
+		}
+		
+		int8_t firstlevel=( (ispotwY == NULL) && (tiles.anztiles <= 0) );
+		if (firstlevel>0) cmprintf(task,"allocating ");
+		
+		int32_t LOCALLENY=enclosementall.y1-enclosementall.y0 + 1;
+		int32_t LOCALLENX=mem1-mem0+1;
+
+		if (tiled>0) {
+			// the tiles of all enclosements, with a gray start
+			// value all tiles of rows intersecting an enclosement
+			// as the row storage has
+			int64_t maxtiles=0;
+			for(int32_t k=0;k<onecycle.cyclelen;k++) {
+				int64_t tm0=onecycle.cycle[k].mem0 >> TILESHIFTM;
+				int64_t tm1=onecycle.cycle[k].mem1 >> TILESHIFTM;
+				if (startwith != ALL32POTW) {
+					tm0=mem0 >> TILESHIFTM;
+					tm1=mem1 >> TILESHIFTM;
+				}
+				maxtiles += 
+					(tm1-tm0+1) *
+					( (int64_t)(onecycle.cycle[k].y1 >> TILESHIFTY)-(onecycle.cycle[k].y0 >> TILESHIFTY)+1);
+			}
+			tiles.setMaxTiles(maxtiles,
+				mem0 >> TILESHIFTM,mem1 >> TILESHIFTM,
+				enclosementall.y0 >> TILESHIFTY,enclosementall.y1 >> TILESHIFTY
+			);
+			for(int32_t k=0;k<onecycle.cyclelen;k++) {
+				int32_t tm0=onecycle.cycle[k].mem0 >> TILESHIFTM;
+				int32_t tm1=onecycle.cycle[k].mem1 >> TILESHIFTM;
+				if (startwith != ALL32POTW) {
+					tm0=mem0 >> TILESHIFTM;
+					tm1=mem1 >> TILESHIFTM;
+				}
+				for(int32_t ty=(onecycle.cycle[k].y0 >> TILESHIFTY);ty<=(onecycle.cycle[k].y1 >> TILESHIFTY);ty++) {
+					for(int32_t tm=tm0;tm<=tm1;tm++) {
+						tiles.addTile(tm,ty);
+					}
+				}
+			}
+			tiles.mortonOrder();
+			levelfootprint=(int64_t)tiles.anztiles*TILEWORDS*sizeof(DDBYTE);
+			printfootprint(task,levelfootprint);
+			tiles.allocateWords();
+			
+			if (startwith != ALL32POTW) {
+				for(int32_t t=0;t<tiles.anztiles;t++) {
+					for(int32_t r=0;r<TILEROWS;r++) {
+						int32_t y=(tiles.tiley[t] << TILESHIFTY)+r;
+						int8_t inenclosement=0;
+						for(int32_t k=0;k<onecycle.cyclelen;k++) {
+							if ( (y >= onecycle.cycle[k].y0) && (y <= onecycle.cycle[k].y1) ) {
+								inenclosement=1;
+								break;
+							}
+						}
+						if (inenclosement<=0) continue;
+						for(int32_t w=0;w<TILEMEMS;w++) {
+							int32_t m=(tiles.tilem[t] << TILESHIFTM)+w;
+							if ( (m >= mem0) && (m <= mem1) ) {
+								tiles.words[(int64_t)t*TILEWORDS + (r << TILESHIFTM) + w]=startwith;
+							}
+						}
+					}
+				}
+			}
+		} else {
+			if (ywithgray) delete[] ywithgray;
+			ywithgray=new int8_t[LOCALLENY];
+			for(int32_t y=0;y<LOCALLENY;y++) {
+				ywithgray[y]=0;
+			}
+
+			// now go over the enclosements again and
+			// set rows intersecting an enclosement to 1
+			// so memory gets allocated and the row checked
+			for(int32_t k=0;k<onecycle.cyclelen;k++) {
+				for(int32_t y=onecycle.cycle[k].y0;y<=onecycle.cycle[k].y1;y++) {
+					ywithgray[y-enclosementall.y0]=1;
+				}
+			}
+			
+			int64_t bitmapbytes=0;
+			for(int32_t y=0;y<LOCALLENY;y++) {
+				if (ywithgray[y]>0) bitmapbytes += (int64_t)LOCALLENX*sizeof(DDBYTE);
+			}
+			levelfootprint=bitmapbytes;
+			printfootprint(task,bitmapbytes);
+
+			// allocate enough memory
+			mgr.ReleaseAll();
+			// now pointers in zeilenY are invalid
+			// now delete that array
+			if (ispotwY) delete[] ispotwY;
+			ispotwY=new PDDBYTE[LOCALLENY];
+			if (!ispotwY) {
+				LOGMSG("Memory error. ispotwY\n");
+				fail();
+			}
+
+			for(int32_t y=0;y<LOCALLENY;y++) {
+				if (ywithgray[y]>0) {
+					ispotwY[y]=mgr.getMemory(LOCALLENX);
+					if (!ispotwY[y]) {
+						LOGMSG("Memory error. ispotwY/2\n");
+						fail();
+					}
+					// set ALL to startvalue
+					for(int32_t m=0;m<LOCALLENX;m++) {
+						ispotwY[y][m]=startwith;
+					}
+				} else {
+					ispotwY[y]=NULL;
+				}
+			}
+		}
+		
+		// setting all enclosements of periodic points
+		// to GRAY
+		for(int32_t k=0;k<onecycle.cyclelen;k++) {
+			for(int32_t y=onecycle.cycle[k].y0;y<=onecycle.cycle[k].y1;y++) {
+				for(int32_t m=onecycle.cycle[k].mem0;m<=onecycle.cycle[k].mem1;m++) {
+					SET32_MY(m,y,ALL32GRAY);
+				}
+			}
+		}
+		
+		// going over the interesting (GRAY) regions
+		// and try to propagate POTENTIALLY_WHITE until
+		// no change occurs
+		// anything still GRAY is then bounded
+		// and means, BLACK will emerge at level REFINEMENT
+		// in the fullTSA
+		
+		if (firstlevel>0) cmprintf(task," analyzing ");
+		else cmprintf(task," ");
+		
+		// CHECKPOINT: geometry of this level
+		time_t lastcheckpoint=time(NULL);
+		if (task.ckpt) {
+			CheckpointHeader& h=*task.ckpt;
+			h.tiled=tiled;
+			h.enclosementall=enclosementall;
+			h.mem0=mem0;
+			h.lenx=LOCALLENX;
+			h.leny=LOCALLENY;
+			h.anztiles=tiles.anztiles;
+			h.encw=encw;
+			if ( 
+				(h.level == REFINEMENT) &&
+				(h.levelprec == levelprecision(REFINEMENT))
+			) {
+				// RESUME: continuing from the bitmap of the checkpoint,
+				// the fixed point is the same
+				if (readcheckpointbitmap(task.resumefn,h,ispotwY,tiles) > 0) {
+					cmprintf(task,"resumed ");
+				} else {
+					cmprintf(task,"(checkpoint bitmap not usable) ");
+				}
+			}
+			h.level=REFINEMENT;
+			h.levelprec=levelprecision(REFINEMENT);
+		}
+		
+		int8_t changed=1;
+		int32_t noch0=256*(24-REFINEMENT);
+		if (noch0<1) noch0=1;
+		int32_t noch=1;
+		
+		if (_PROPAGATION==PROPAGATION_WORKLIST) {
+			// reverse dependency graph: for every gray cell the list
+			// of cells whose bounding box hits it. Every cell is evaluated
+			// once, afterwards only the dependents of a cell that just
+			// turned POTW are set to POTW, too. That is the same fixed
+			// point the sweep below reaches
+			
+			// cell index: number of gray cells before the word plus
+			// number of gray bits below the cell in its word
+			int32_t** cellbaseY=new int32_t*[LOCALLENY];
+			int64_t anzcells=0;
+			// memory of the worklist, counted with the bitmap
+			// blocks against MEMLIMIT
+			int64_t worklistbytes=0;
+			for(int32_t y=0;y<LOCALLENY;y++) {
+				cellbaseY[y]=NULL;
+				if (ywithgray[y]<=0) continue;
+				
+				cellbaseY[y]=new int32_t[LOCALLENX];
+				worklistbytes += (int64_t)LOCALLENX*sizeof(int32_t);
+				for(int32_t m=0;m<LOCALLENX;m++) {
+					cellbaseY[y][m]=(int32_t)anzcells;
+					anzcells += __builtin_popcount(~ispotwY[y][m]);
+				}
+			}
+			
+			// the memory of cells and edges is within
+			// WORKLISTMAXBYTES and MEMLIMIT
+			auto worklistfits=[&](const int64_t abytes) {
+				if (abytes > WORKLISTMAXBYTES) return 0;
+				if ( (_MEMLIMIT > 0) && ( (blocksinram.load()+abytes) > _MEMLIMIT) ) return 0;
+				return 1;
+			};
+			worklistbytes += anzcells*(
+				3*sizeof(int32_t)+sizeof(int8_t)+sizeof(ScreenRect)+sizeof(int64_t)
+			) + sizeof(int64_t);
+			
+			if (anzcells >= INT32_MAX) {
+				cmprintf(task,"\n  too many gray cells for worklist propagation, sweeping instead\n");
+			} else if (worklistfits(worklistbytes) <= 0) {
+				cmprintf(task,"\n  worklist of %.0lf MB above the memory budget, sweeping instead\n",(double)worklistbytes/(1 << 20));
+			} else {
+				blocksinram.fetch_add(worklistbytes);
+				
+				#define CELLIDX_XY(XX,YY,ERG) \
+				{\
+					ERG=-1;\
+					if (\
+						( (XX) >= enclosementall.x0) &&\
+						( (XX) <= enclosementall.x1) &&\
+						( (YY) >= enclosementall.y0) &&\
+						( (YY) <= enclosementall.y1) &&\
+						(cellbaseY[ (YY)-enclosementall.y0 ]) \
+					) {\
+						int bmem=((XX) >> SHIFTPERDDBYTE)-mem0;\
+						DDBYTE f32=ispotwY[ (YY)-enclosementall.y0 ][bmem];\
+						int bbit=(XX) % (1 << SHIFTPERDDBYTE);\
+						if ( ((f32 >> bbit) & 0b1) == SQUARE_GRAY) {\
+							ERG=cellbaseY[ (YY)-enclosementall.y0 ][bmem] +\
+								__builtin_popcount( (~f32) & ( (((DDBYTE)1) << bbit)-1) );\
+						}\
+					}\
+				}
+				
+				#define SETCELLPOTW(IDX) \
+				{\
+					ispotwY[ celly[IDX]-enclosementall.y0 ][ (cellx[IDX] >> SHIFTPERDDBYTE)-mem0 ] |= \
+						((DDBYTE)1 << (cellx[IDX] % (1 << SHIFTPERDDBYTE)));\
+				}
+				
+				// not enough memory: the sweep below instead,
+				// the bitmap is not changed before the edges exist
+				int32_t *cellx=new (std::nothrow) int32_t[anzcells];
+				int32_t *celly=new (std::nothrow) int32_t[anzcells];
+				int8_t *cellpotw=new (std::nothrow) int8_t[anzcells];
+				ScreenRect *cellscr=new (std::nothrow) ScreenRect[anzcells];
+				int32_t *queue=new (std::nothrow) int32_t[anzcells];
+				int64_t *depstart=new (std::nothrow) int64_t[anzcells+1];
+				int32_t *deps=NULL;
+				int64_t depsbytes=0;
+				int8_t worklist=( (cellx) && (celly) && (cellpotw) && (cellscr) && (queue) && (depstart) );
+				if (worklist <= 0) {
+					cmprintf(task,"\n  worklist not allocated, sweeping instead\n");
+				}
+				int32_t queuelen=0;
+				
+				if (worklist > 0) {
+					npasses++;
+					
+					// (1) evaluate every gray cell once against the
+					// start bitmap. Cells turning POTW are only marked,
+					// so the bitmap stays valid for the cell indices
+					auto evaluaterow=[&](const int32_t y) {
+						int32_t yrel=y-enclosementall.y0;
+						if (!cellbaseY[yrel]) return;
+						
+						PlaneRectT<T> A;
+						A.y0=y*scaleRangePerPixel + NC::COMPLETE0;
+						A.y1=A.y0+scaleRangePerPixel;
+						int64_t graycells=0,hitpixels=0;
+						for(int32_t m=mem0;m<=mem1;m++) {
+							DDBYTE ff=ispotwY[yrel][m-mem0];
+							if (ff == ALL32POTW) continue;
+							graycells += __builtin_popcount(~ff);
+							int32_t idx=cellbaseY[yrel][m-mem0];
+							uint32_t xcoord0=m << SHIFTPERDDBYTE;
+							
+							ScreenRect scr[32];
+							DDBYTE inside=wordscreenrects(m,ff,A,scr);
+							
+							for(int32_t bit=0;bit<32;bit++) {
+								BYTE tmpf=ff & 0b1;
+								ff >>= 1;
+								if (tmpf == SQUARE_POTW) continue;
+								
+								int xc=xcoord0+bit;
+								cellx[idx]=xc;
+								celly[idx]=y;
+								depstart[idx]=0;
+								
+								int8_t hitspotentiallywhite=1;
+								if ( (inside >> bit) & 0b1 ) {
+									cellscr[idx]=scr[bit];
+									RECT_HITS_POTW(cellscr[idx],hitspotentiallywhite);
+								}
+								cellpotw[idx]=hitspotentiallywhite;
+								idx++;
+							} // bit
+						} // m
+						if (counting>0) {
+							ncells.fetch_add(graycells,std::memory_order_relaxed);
+							npixels.fetch_add(hitpixels,std::memory_order_relaxed);
+						}
+					};
+					parallel_rows(task.threads,enclosementall.y0,enclosementall.y1,evaluaterow);
+					
+					for(int32_t i=0;i<anzcells;i++) {
+						if (cellpotw[i]>0) {
+							queue[queuelen]=i;
+							queuelen++;
+						}
+					}
+					depstart[anzcells]=0;
+					
+					// (2) reverse edges. All pixels hit by a remaining
+					// cell are gray, hence have an index
+					for(int32_t i=0;i<anzcells;i++) {
+						if (cellpotw[i]>0) continue;
+						for(int32_t by=cellscr[i].y0;by<=cellscr[i].y1;by++) {
+							for(int32_t bx=cellscr[i].x0;bx<=cellscr[i].x1;bx++) {
+								int32_t j;
+								CELLIDX_XY(bx,by,j);
+								depstart[j]++;
+							}
+						}
+					}
+					for(int32_t i=1;i<=anzcells;i++) {
+						depstart[i] += depstart[i-1];
+					}
+					depsbytes=(depstart[anzcells]+1)*sizeof(int32_t);
+					if (worklistfits(worklistbytes+depsbytes) <= 0) {
+						cmprintf(task,"\n  worklist edges of %.0lf MB above the memory budget, sweeping instead\n",(double)depsbytes/(1 << 20));
+						worklist=0;
+					} else {
+						deps=new (std::nothrow) int32_t[depstart[anzcells]+1];
+						if (!deps) {
+							cmprintf(task,"\n  worklist edges not allocated, sweeping instead\n");
+							worklist=0;
+						}
+					}
+				} // worklist
+				
+				if (worklist > 0) {
+					blocksinram.fetch_add(depsbytes);
+					changed=0;
+					for(int32_t i=0;i<anzcells;i++) {
+						if (cellpotw[i]>0) continue;
+						for(int32_t by=cellscr[i].y0;by<=cellscr[i].y1;by++) {
+							for(int32_t bx=cellscr[i].x0;bx<=cellscr[i].x1;bx++) {
+								int32_t j;
+								CELLIDX_XY(bx,by,j);
+								depstart[j]--;
+								deps[depstart[j]]=i;
+							}
+						}
+					}
+					// now the dependents of cell i are deps[depstart[i]..depstart[i+1]-1]
+					
+					for(int32_t q=0;q<queuelen;q++) {
+						SETCELLPOTW(queue[q])
+					}
+					
+					// (3) propagate
+					int32_t queuepos=0;
+					while (queuepos < queuelen) {
+						if ((queuepos & ((1 << 20)-1))==0) cmprintf(task,".");
+						int32_t i=queue[queuepos];
+						queuepos++;
+						for(int64_t d=depstart[i];d<depstart[i+1];d++) {
+							int32_t j=deps[d];
+							if (cellpotw[j]>0) continue;
+							cellpotw[j]=1;
+							SETCELLPOTW(j)
+							queue[queuelen]=j;
+							queuelen++;
+						}
+					}
+					blocksinram.fetch_sub(depsbytes);
+				} // worklist
+				
+				delete[] deps;
+				delete[] depstart;
+				delete[] queue;
+				delete[] cellscr;
+				delete[] cellpotw;
+				delete[] celly;
+				delete[] cellx;
+				blocksinram.fetch_sub(worklistbytes);
+			}
+			
+			for(int32_t y=0;y<LOCALLENY;y++) {
+				if (cellbaseY[y]) delete[] cellbaseY[y];
+			}
+			delete[] cellbaseY;
+		}
+		
+		// INCREMENTAL: the sequence number of every cell turning
+		// POTW is noted
+		std::atomic<uint32_t> rankseq(1);
+		#define SETRANKS(MM,YY,FF32) \
+		{\
+			if (rankY) {\
+				uint32_t r=rankseq.fetch_add(__builtin_popcount(FF32),std::memory_order_relaxed);\
+				uint32_t* rk=&rankY[ (YY)-enclosementall.y0 ][ ((MM)-mem0) << SHIFTPERDDBYTE ];\
+				for(int32_t bit=0;bit<32;bit++) {\
+					if ( ((FF32) >> bit) & 0b1 ) {\
+						rk[bit]=r;\
+						r++;\
+					}\
+				}\
+			}\
+		}
+		
+		// does cell A turn POTW
+		auto cellturnspotw=[&](PlaneRectT<T>& A) {
+			// bbxfA overlaps with outside of cycle enclosement (local)
+			ScreenRect scr;
+			if (counting>0) {
+				ncells.fetch_add(1,std::memory_order_relaxed);
+				nbbx.fetch_add(1,std::memory_order_relaxed);
+			}
+			if (getScreenRectfA(grid,A,scr) <= 0) return (int8_t)1;
+			
+			// check the intersected with pixels
+			int8_t hitspotentiallywhite;
+			int64_t hitpixels=0;
+			RECT_HITS_POTW(scr,hitspotentiallywhite);
+			if (counting>0) npixels.fetch_add(hitpixels,std::memory_order_relaxed);
+			
+			return hitspotentiallywhite;
+		};
+		
+		// one word of the sweep, returns 0 if it was all POTW
+		// already. Rows are processed in parallel if THREADS > 1,
+		// every row is only written by the thread working on it,
+		// the other threads only read
+		std::atomic<int32_t> rowchanged(0);
+		auto sweepword=[&](const int32_t y,const int32_t m,PlaneRectT<T>& A) {
+			DDBYTE ff;
+			GET32_MY(m,y,ff);
+			if (ff == ALL32POTW) return 0;
+			DDBYTE fneu=0;
+			int64_t hitpixels=0;
+			if (counting>0) ncells.fetch_add(__builtin_popcount(~ff),std::memory_order_relaxed);
+			
+			ScreenRect scr[32];
+			DDBYTE inside=wordscreenrects(m,ff,A,scr);
+			
+			for(int32_t bit=0;bit<32;bit++) {
+				BYTE tmpf=ff & 0b1;
+				ff >>= 1;
+				if (tmpf == SQUARE_POTW) continue;
+				
+				// bbxfA overlaps with outside of cycle enclosement (local)
+				int8_t hitspotentiallywhite=1;
+				if ( (inside >> bit) & 0b1 ) {
+					RECT_HITS_POTW(scr[bit],hitspotentiallywhite);
+				}
+				
+				if (hitspotentiallywhite > 0) {
+					fneu |= (1 << bit);
+				}
+			} // bit
+			if (counting>0) npixels.fetch_add(hitpixels,std::memory_order_relaxed);
+			
+			if (fneu != 0) {
+				rowchanged.store(1,std::memory_order_relaxed);
+				OR32_MY(m,y,fneu);
+				SETRANKS(m,y,fneu)
+			}
+			
+			return 1;
+		};
+		
+		auto sweeprow=[&](const int32_t y) {
+			if (ywithgray[y-enclosementall.y0]<=0) return;
+			
+			int8_t graythere=0;
+			PlaneRectT<T> A;
+			
+			A.y0=y*scaleRangePerPixel + NC::COMPLETE0;
+			A.y1=A.y0+scaleRangePerPixel;
+			for(int32_t m=mem0;m<=mem1;m++) {
+				if (sweepword(y,m,A) > 0) graythere=1;
+			} // m
+			
+			if (graythere<=0) {
+				ywithgray[y-enclosementall.y0]=0;
+			}
+		};
+		
+		// the same for the 64 rows of tile t
+		auto sweeptile=[&](const int32_t t) {
+			if (tiles.tilewithgray[t]<=0) return;
+			
+			int8_t graythere=0;
+			PlaneRectT<T> A;
+			PTILEROW trows=(PTILEROW)&tiles.words[(int64_t)t*TILEWORDS];
+			for(int32_t r=0;r<TILEROWS;r++) {
+				if (ATOMIC_LOAD64(&trows[r]) == ALL64POTW) continue;
+				int32_t y=(tiles.tiley[t] << TILESHIFTY)+r;
+				A.y0=y*scaleRangePerPixel + NC::COMPLETE0;
+				A.y1=A.y0+scaleRangePerPixel;
+				for(int32_t w=0;w<TILEMEMS;w++) {
+					if (sweepword(y,(tiles.tilem[t] << TILESHIFTM)+w,A) > 0) graythere=1;
+				}
+			}
+			
+			if (graythere<=0) {
+				tiles.tilewithgray[t]=0;
+			}
+		};
+		
+		if ( (_INCREMENTAL>0) && (_PROPAGATION==PROPAGATION_SWEEP) ) {
+			// a first pass going over the cells in the order their
+			// parent cells (2x2 cells of this level per cell of the
+			// previous one) turned POTW at the previous level. POTW
+			// information then mostly propagates within that pass
+			// and the following sweeps only confirm the fixed point
+			int32_t anzorder=0;
+			int32_t* orderx=NULL;
+			int32_t* ordery=NULL;
+			
+			// parent at a level rankshift levels lower
+			int32_t rankshift=REFINEMENT-ranklevel;
+			if (rankshift <= 0) rankshift=-1;
+			
+			#define PARENTRANK(XX,YY,ERG) \
+			{\
+				ERG=0;\
+				int32_t px=(XX) >> rankshift;\
+				int32_t py=(YY) >> rankshift;\
+				if (\
+					(rankY) &&\
+					(py >= ranky0) && (py < (ranky0+ranklenY)) &&\
+					(px >= (rankmem0 << SHIFTPERDDBYTE)) &&\
+					(px < ((rankmem1+1) << SHIFTPERDDBYTE)) &&\
+					(rankY[py-ranky0])\
+				) {\
+					ERG=rankY[py-ranky0][px-(rankmem0 << SHIFTPERDDBYTE)];\
+				}\
+			}
+			
+			// all gray cells with a known parent rank
+			#define FORALLRANKEDCELLS(CODE) \
+			{\
+				for(int32_t y=enclosementall.y0;y<=enclosementall.y1;y++) {\
+					if (!ispotwY[y-enclosementall.y0]) continue;\
+					for(int32_t m=mem0;m<=mem1;m++) {\
+						DDBYTE ff=ispotwY[y-enclosementall.y0][m-mem0];\
+						if (ff == ALL32POTW) continue;\
+						for(int32_t bit=0;bit<32;bit++) {\
+							if ( ((ff >> bit) & 0b1) == SQUARE_POTW) continue;\
+							int32_t x=(m << SHIFTPERDDBYTE)+bit;\
+							uint32_t r;\
+							PARENTRANK(x,y,r)\
+							if (r <= 0) continue;\
+							CODE\
+						}\
+					}\
+				}\
+			}
+			
+			if ( (rankY) && (rankshift > 0) ) {
+				// counting sort by parent rank
+				int32_t* anzrank=new int32_t[rankmax+2];
+				for(uint32_t r=0;r<=(rankmax+1);r++) anzrank[r]=0;
+				FORALLRANKEDCELLS( anzrank[r+1]++; anzorder++; )
+				for(uint32_t r=1;r<=(rankmax+1);r++) anzrank[r] += anzrank[r-1];
+				orderx=new int32_t[anzorder+1];
+				ordery=new int32_t[anzorder+1];
+				if ( (!orderx) || (!ordery) ) {
+					LOGMSG("Memory error. incremental\n");
+					fail();
+				}
+				FORALLRANKEDCELLS( orderx[anzrank[r]]=x; ordery[anzrank[r]]=y; anzrank[r]++; )
+				delete[] anzrank;
+			}
+			if (rankY) {
+				for(int32_t y=0;y<ranklenY;y++) {
+					if (rankY[y]) delete[] rankY[y];
+				}
+				delete[] rankY;
+			}
+			
+			// ranks of this level for the next one
+			rankY=new uint32_t*[LOCALLENY];
+			ranky0=enclosementall.y0;
+			ranklenY=LOCALLENY;
+			rankmem0=mem0;
+			rankmem1=mem1;
+			ranklevel=REFINEMENT;
+			for(int32_t y=0;y<LOCALLENY;y++) {
+				if (ispotwY[y]) {
+					int32_t len=LOCALLENX << SHIFTPERDDBYTE;
+					rankY[y]=new uint32_t[len];
+					if (!rankY[y]) {
+						LOGMSG("Memory error. incremental/2\n");
+						fail();
+					}
+					for(int32_t x=0;x<len;x++) rankY[y][x]=0;
+				} else {
+					rankY[y]=NULL;
+				}
+			}
+			
+			PlaneRectT<T> A;
+			if (anzorder > 0) npasses++;
+			for(int32_t i=0;i<anzorder;i++) {
+				int32_t m=orderx[i] >> SHIFTPERDDBYTE;
+				DDBYTE ff;
+				GET32_MY(m,ordery[i],ff);
+				DDBYTE fbit=(DDBYTE)1 << (orderx[i] % (1 << SHIFTPERDDBYTE));
+				if ( (ff & fbit) != 0) continue;
+				
+				A.x0=orderx[i]*scaleRangePerPixel + NC::COMPLETE0;
+				A.x1=A.x0+scaleRangePerPixel;
+				A.y0=ordery[i]*scaleRangePerPixel + NC::COMPLETE0;
+				A.y1=A.y0+scaleRangePerPixel;
+				if (cellturnspotw(A) > 0) {
+					OR32_MY(m,ordery[i],fbit);
+					SETRANKS(m,ordery[i],fbit)
+				}
+			}
+			if (orderx) delete[] orderx;
+			if (ordery) delete[] ordery;
+		}
+		
+		while (changed>0) {
+			changed=0;
+			npasses++;
+			if ((--noch)<=0) {
+				cmprintf(task,".");
+				noch=noch0;
+			}
+			
+			// go over enclosementall, so points in overlapping
+			// enclosement[k]'s will not be analyzed twice
+			// in that round of the while-loop
+			rowchanged.store(0);
+			if (tiled>0) parallel_rows(task.threads,0,tiles.anztiles-1,sweeptile);
+			else parallel_rows(task.threads,enclosementall.y0,enclosementall.y1,sweeprow);
+			changed=rowchanged.load();
+			
+			if ( 
+				(changed > 0) && (task.ckpt) && (_CHECKPOINTFILE[0]) &&
+				( (time(NULL)-lastcheckpoint) >= _CHECKPOINTSECONDS)
+			) {
+				if (writecheckpoint(task.ckptfn,*task.ckpt,ispotwY,tiles) > 0) cmprintf(task,"c");
+				lastcheckpoint=time(NULL);
+			}
+		} // main-while loop as long as new information
+		// is being created
+		
+		rankmax=rankseq.load();
+		
+		// if GRAY cells are present = black emerges
+		interiorpresentat=0;
+		if (tiled>0) {
+			int64_t len=(int64_t)tiles.anztiles*TILEWORDS;
+			for(int64_t i=0;i<len;i++) {
+				if (tiles.words[i] != ALL32POTW) {
+					interiorpresentat=REFINEMENT;
+					break;
+				}
+			}
+		}
+		// ywithgray: not indicative any more of pointer present
+		if (tiled<=0) for(int32_t y=0;y<LOCALLENY;y++) {
+			if (!ispotwY[y]) continue;
+			
+			for(int32_t m=0;m<LOCALLENX;m++) {
+				// is cell still GRAY
+				if (ispotwY[y][m] != ALL32POTW) {
+					interiorpresentat=REFINEMENT;
+					break;
+				} // m
+				if (interiorpresentat>0) break;
+			}
+			if (interiorpresentat>0) break;
+		} // k
+		
+		rcache.store(cachekey,REFINEMENT,levelprec,(interiorpresentat > 0));
+		if ( 
+			(task.ckpt) &&
+			// ENCW=AUTO: negative only at the largest width
+			( (_ENCWAUTO <= 0) || (interiorpresentat > 0) || (encw >= _ENCLOSEMENTWIDTH) )
+		) {
+			// the outcome is kept, the bitmap is not needed any more
+			task.ckpt->outcome[REFINEMENT]=(interiorpresentat > 0);
+			task.ckpt->outcomeprec[REFINEMENT]=levelprecision(REFINEMENT);
+			task.ckpt->level=0;
+			if (_CHECKPOINTFILE[0]) writecheckpoint(task.ckptfn,*task.ckpt,ispotwY,tiles);
+		}
+		
+		// EXPORT: the bitmap of the lowest level found black so far
+		if ( 
+			(interiorpresentat > 0) && (task.exportfn[0]) &&
+			( (task.exportlevel <= 0) || (REFINEMENT < task.exportlevel) )
+		) {
+			ExportHeader eh;
+			memset(&eh,0,sizeof(eh));
+			recordfuncname(eh.func);
+			eh.cre=(double)cplxC.re;
+			eh.cim=(double)cplxC.im;
+			eh.are=(double)cplxA.re;
+			eh.aim=(double)cplxA.im;
+			eh.complete0=(double)COMPLETE0;
+			eh.complete1=(double)COMPLETE1;
+			eh.level=REFINEMENT;
+			eh.levelprec=levelprecision(REFINEMENT);
+			eh.cyclenumber=onecycle.cyclenumber;
+			eh.period=onecycle.cyclelen;
+			eh.encw=encw;
+			eh.enclosementall=enclosementall;
+			eh.pixels=enclosementall;
+			eh.pixels.x0=mem0 << SHIFTPERDDBYTE;
+			eh.pixels.x1=( (mem1+1) << SHIFTPERDDBYTE)-1;
+			if (writeexport(task.exportfn,eh,ispotwY,tiles,tiled,mem0) > 0) {
+				task.exportlevel=REFINEMENT;
+			} else {
+				cmprintf(task,"\nexport file %s not writeable",task.exportfn);
+			}
+		}
+		
+		notelevel(REFINEMENT,LEVELSOURCE_COMPUTED);
+
+		return interiorpresentat;
+	}; // analyzeencw
+	
+	// widths the levels were analyzed with
+	int32_t encwlevel[32];
+	for(int32_t l=0;l<32;l++) encwlevel[l]=_ENCLOSEMENTWIDTH;
+	
+	auto analyzelevel=[&](const int32_t REFINEMENT) {
+		if (_ENCWAUTO <= 0) return analyzeencw(REFINEMENT);
+		
+		// ENCW=AUTO: doubling the enclosements until black emerges.
+		// The gray cells of an enclosement map into themselves, so
+		// they stay gray in any larger one: the result is that of the
+		// largest width. A negative smaller width leaves no gray cell,
+		// nothing of its bitmap carries over but the memory
+		encw=ENCWAUTOMIN;
+		if (
+			(task.ckpt) && (task.ckpt->level == REFINEMENT) && 
+			(task.ckpt->encw > encw)
+		) {
+			// smaller widths were negative before the checkpoint
+			encw=task.ckpt->encw;
+		}
+		if ( 
+			(task.ckpt) && 
+			(task.ckpt->outcome[REFINEMENT] >= 0) &&
+			(task.ckpt->outcomeprec[REFINEMENT] == levelprecision(REFINEMENT))
+		) {
+			// final outcome of the level known
+			encw=_ENCLOSEMENTWIDTH;
+		}
+		if (encw > _ENCLOSEMENTWIDTH) encw=_ENCLOSEMENTWIDTH;
+		while (1) {
+			cyclecachekey(onecycle,startwith,encw,cachekey);
+			int32_t ip=analyzeencw(REFINEMENT);
+			encwlevel[REFINEMENT]=encw;
+			if ( (ip > 0) || (encw >= _ENCLOSEMENTWIDTH) ) return ip;
+			// the next width starts afresh, not from this bitmap
+			if (task.ckpt) task.ckpt->level=0;
+			encw <<= 1;
+			if (encw > _ENCLOSEMENTWIDTH) encw=_ENCLOSEMENTWIDTH;
+		}
+	}; // analyzelevel
+	
+	// bounding boxes of the levels analyzed
+	PlaneRect basinrect[32];
+	int8_t probed[32];
+	for(int32_t l=0;l<32;l++) probed[l]=0;
+	
+	if (_SEARCH==SEARCH_GALLOP) {
+		// probing levels alevel0, +1, +3, +7,... until one is positive
+		// then bisecting between the last negative and that level.
+		// Levels not probed are assumed to behave monotone
+		int32_t lastneg=alevel0-1,firstpos=-1;
+		int32_t step=1;
+		int32_t REFINEMENT=alevel0;
+		while (REFINEMENT <= alevel1) {
+			int32_t ip=analyzelevel(REFINEMENT);
+			basinrect[REFINEMENT]=onecycle.ps_basinrect;
+			probed[REFINEMENT]=1;
+			if (ip > 0) {
+				firstpos=REFINEMENT;
+				break;
+			}
+			lastneg=REFINEMENT;
+			if (REFINEMENT == alevel1) break;
+			REFINEMENT += step;
+			step <<= 1;
+			if (REFINEMENT > alevel1) REFINEMENT=alevel1;
+		}
+		
+		if (firstpos > 0) {
+			int32_t lo=lastneg,hi=firstpos;
+			while ( (hi-lo) > 1) {
+				int32_t mid=(lo+hi) >> 1;
+				int32_t ip=analyzelevel(mid);
+				basinrect[mid]=onecycle.ps_basinrect;
+				probed[mid]=1;
+				if (ip > 0) hi=mid; else lo=mid;
+			}
+			interiorpresentat=hi;
+			onecycle.ps_basinrect=basinrect[hi];
+			// the result is only the first positive level if the
+			// levels skipped while galloping are negative, too
+			int8_t skipped=0;
+			for(int32_t l=alevel0;l<hi;l++) {
+				if (probed[l]>0) continue;
+				if (skipped<=0) cmprintf(task,"\n  (gallop: level");
+				cmprintf(task," %i",l);
+				skipped=1;
+			}
+			if (skipped>0) cmprintf(task," not probed, black might emerge there already)");
+		} else {
+			interiorpresentat=0;
+		}
+	} else {
+		for(int32_t REFINEMENT=alevel0;REFINEMENT<=alevel1;REFINEMENT++) {
+			if (analyzelevel(REFINEMENT) > 0) {
+				interiorpresentat=REFINEMENT;
+				break;
+			}
+		}
+	}
+	
+	onecycle.interiorfound=interiorpresentat;
+	onecycle.encw=(interiorpresentat > 0 ? encwlevel[interiorpresentat] : _ENCLOSEMENTWIDTH);
+	delete[] ywithgray;
+	if (rankY) {
+		for(int32_t y=0;y<ranklenY;y++) {
+			if (rankY[y]) delete[] rankY[y];
+		}
+		delete[] rankY;
+	}
+	mgr.ReleaseAll();
+	if (ispotwY) delete[] ispotwY;
+	tiles.clearTiles();
+
+	return interiorpresentat;
+}
+
+// SEARCH=PREDICT: first level black is plausible at. Around an
+// attracting periodic point the cells contract by |multiplier| per
+// period up to the scale where f is no longer linear, here taken as
+// the distance to the nearest critical point or half the distance
+// to the next periodic point. Every step of the period widens the
+// bounding boxes, hence the term in log2(period)
+int32_t predictlevel(Root& onecycle) {
+	double s=-1.0;
+	for(int32_t k=0;k<onecycle.cyclelen;k++) {
+		for(int32_t cp=0;cp<nbr_of_cp;cp++) {
+			Complex d=onecycle.cycle[k].pp-zero[cp].attractor;
+			double dd=(double)d.norm();
+			if ( (s < 0.0) || (dd < s) ) s=dd;
+		}
+		for(int32_t j=(k+1);j<onecycle.cyclelen;j++) {
+			Complex d=onecycle.cycle[k].pp-onecycle.cycle[j].pp;
+			double dd=0.5*(double)d.norm();
+			if ( (s < 0.0) || (dd < s) ) s=dd;
+		}
+	}
+	
+	double h=(1.0-onecycle.multiplier)*s;
+	// neutral: only the highest level might show black
+	if (h <= 0.0) return LEVEL1;
+	double est=
+		log((double)(COMPLETE1-COMPLETE0)/h)/log(2.0) +
+		log((double)onecycle.cyclelen)/log(2.0) +
+		PREDICTOFFSET - PREDICTMARGIN;
+	if (est <= LEVEL0) return LEVEL0;
+	if (est >= LEVEL1) return LEVEL1;
+	
+	return (int32_t)floor(est);
+}
+
+int cm_local(Root& onecycle,const DDBYTE startwith,CmTask& task) {
+	double t0=wallseconds();
+	if ( (_METRICSFILE[0]) || (_BENCH > 0) ) {
+		if (!onecycle.metrics) onecycle.metrics=new LevelMetrics[MAXLEVELMETRICS];
+		onecycle.anzmetrics=0;
+	}
+	
+	// CHECKPOINT/RESUME: file <name>.c<cycle number>, a checkpoint
+	// of different parameters is not used
+	if ( (_CHECKPOINTFILE[0]) || (_RESUMEFILE[0]) ) {
+		task.ckpt=new CheckpointHeader;
+		CheckpointHeader& ckpt=*task.ckpt;
+		memset(&ckpt,0,sizeof(ckpt));
+		cyclecachekey(onecycle,startwith,_ENCLOSEMENTWIDTH,ckpt.key);
+		for(int32_t l=0;l<32;l++) ckpt.outcome[l]=-1;
+		if (_RESUMEFILE[0]) {
+			sprintf(task.resumefn,"%s.c%i",_RESUMEFILE,onecycle.cyclenumber);
+			CheckpointHeader h;
+			if (readcheckpointheader(task.resumefn,h) <= 0) {
+				cmprintf(task,"\nno checkpoint %s",task.resumefn);
+			} else if (strcmp(h.key,ckpt.key) != 0) {
+				cmprintf(task,"\ncheckpoint %s is of different parameters, not used",task.resumefn);
+			} else {
+				cmprintf(task,"\nresuming from %s",task.resumefn);
+				if (h.level > 0) cmprintf(task," (level %i in progress)",h.level);
+				ckpt=h;
+			}
+		}
+		if (_CHECKPOINTFILE[0]) sprintf(task.ckptfn,"%s.c%i",_CHECKPOINTFILE,onecycle.cyclenumber);
+	}
+	task.exportfn[0]=0;
+	task.exportlevel=0;
+	if (_EXPORTFILE[0]) sprintf(task.exportfn,"%s.c%i",_EXPORTFILE,onecycle.cyclenumber);
+	
+	// the levels in runs of the same number type, every run
+	// analyzed in its type until one is positive
+	auto levelrange=[&](const int32_t alevel0,const int32_t alevel1) {
+		int32_t ip=0;
+		int32_t l0=alevel0;
+		while ( (l0 <= alevel1) && (ip <= 0) ) {
+			int prec=levelprecision(l0);
+			int32_t l1=l0;
+			while ( (l1 < alevel1) && (levelprecision(l1+1) == prec) ) l1++;
+			
+			if ( (_PRECISION == PRECISION_AUTO) || (_PRECISION == PRECISION_DY) ) {
+				cmprintf(task,"\nlevels %i..%i in %s",l0,l1,precisionname[prec]);
+			}
+			
+			switch (prec) {
+				case PRECISION_LD: ip=cm_local_T<long double>(onecycle,startwith,task,l0,l1); break;
+				case PRECISION_QD: ip=cm_local_T<__float128>(onecycle,startwith,task,l0,l1); break;
+				case PRECISION_DY128: ip=cm_local_T<Dyadic128>(onecycle,startwith,task,l0,l1); break;
+				case PRECISION_DY192: ip=cm_local_T<Dyadic192>(onecycle,startwith,task,l0,l1); break;
+				case PRECISION_DY256: ip=cm_local_T<Dyadic256>(onecycle,startwith,task,l0,l1); break;
+				case PRECISION_DD: ip=cm_local_T<DoubleDouble>(onecycle,startwith,task,l0,l1); break;
+				default: ip=cm_local_T<double>(onecycle,startwith,task,l0,l1); break;
+			}
+			
+			l0=l1+1;
+		}
+		return ip;
+	};
+	
+	int32_t start=LEVEL0;
+	if (_SEARCH==SEARCH_PREDICT) {
+		start=predictlevel(onecycle);
+		cmprintf(task,"\n  predicted start level %i",start);
+	}
+	if ( (_CONTINUE >= 0) && (onecycle.continuelevel > 0) ) {
+		start=onecycle.continuelevel-_CONTINUE;
+		if (start < LEVEL0) start=LEVEL0;
+		if (start > LEVEL1) start=LEVEL1;
+		cmprintf(task,"\n  black at level %i at the previous point, start level %i",onecycle.continuelevel,start);
+	}
+	int32_t interiorpresentat=levelrange(start,LEVEL1);
+	if ( 
+		(start > LEVEL0) && (interiorpresentat == start) &&
+		(_CONTINUE >= 0) && (onecycle.continuelevel > 0)
+	) {
+		// CONTINUE: downwards until a level is negative
+		PlaneRect basinrect=onecycle.ps_basinrect;
+		int32_t encw=onecycle.encw;
+		for(int32_t l=(start-1);l>=LEVEL0;l--) {
+			cmprintf(task,"\n  black at level %i, checking level %i",interiorpresentat,l);
+			if (levelrange(l,l) <= 0) break;
+			interiorpresentat=l;
+			basinrect=onecycle.ps_basinrect;
+			encw=onecycle.encw;
+		}
+		onecycle.ps_basinrect=basinrect;
+		onecycle.encw=encw;
+		onecycle.interiorfound=interiorpresentat;
+	} else if ( (start > LEVEL0) && (interiorpresentat == start) ) {
+		// already the first probe is positive: the levels below
+		// from the bottom as SEARCH=LINEAR would
+		cmprintf(task,"\n  black at the first probe, checking levels %i..%i",LEVEL0,start-1);
+		PlaneRect basinrect=onecycle.ps_basinrect;
+		int32_t encw=onecycle.encw;
+		int32_t ip=levelrange(LEVEL0,start-1);
+		if (ip > 0) {
+			interiorpresentat=ip;
+		} else {
+			onecycle.ps_basinrect=basinrect;
+			onecycle.encw=encw;
+		}
+		onecycle.interiorfound=interiorpresentat;
+	}
+	
+	// EXPORT: a file of a level above the one found (that came
+	// from the cache or a checkpoint) is not kept
+	if ( (task.exportlevel > 0) && (task.exportlevel != interiorpresentat) ) {
+		remove(task.exportfn);
+		task.exportlevel=0;
+	}
+	
+	// cycle done, nothing to resume
+	if (task.ckpt) {
+		if (_CHECKPOINTFILE[0]) remove(task.ckptfn);
+		delete task.ckpt;
+		task.ckpt=NULL;
+	}
+	onecycle.seconds=wallseconds()-t0;
+	
+	return interiorpresentat;
+}
+
+// JOINT=1: the selected cycles level by level on one grid over the
+// union of their enclosements. Every cycle has its own plane of POTW
+// bits, set up as cm_local sets up its bitmap, so every plane reaches
+// the fixed point cm_local reaches for that cycle. The bounding box of
+// a cell is computed once for all planes it is gray in, only the test
+// against local and the hit test are per plane
+const int32_t MAXJOINT=32;
+
+struct JointPlane {
+	Root* cycle;
+	int8_t active; // level not found yet
+	ScreenRect all; // enclosementall of the cycle
+	PDDBYTE* rows; // over the union, NULL = POTW
+	// outcome of the level: JOINT_...
+	int8_t outcome;
+	uint32_t contains; // planes whose periodic points lie in the gray cells
+};
+
+enum {
+	JOINT_NOGRAY=0,JOINT_OWN=1,JOINT_OTHER=2,JOINT_NONE=3
+};
+
+// one level of the active planes in the number type T
+template<class T>
+void cm_joint_T(JointPlane* planes,const int32_t anz,const DDBYTE startwith,CmTask& task,const int32_t REFINEMENT) {
+	typedef NumCore<T> NC;
+	const int64_t SCREENWIDTH=( (int64_t)1 << REFINEMENT);
+	const T scaleRangePerPixel=(NC::COMPLETE1-NC::COMPLETE0)/(double)SCREENWIDTH;
+	const T scalePixelPerRange=(double)SCREENWIDTH/(NC::COMPLETE1-NC::COMPLETE0);
+	const int32_t encw=_ENCLOSEMENTWIDTH;
+	PlaneRectT<T> local[MAXJOINT];
+	
+	// enclosements as in cm_local, the union of those of the active planes
+	ScreenRect U;
+	U.x0=U.y0=(int32_t)(SCREENWIDTH-1);
+	U.x1=U.y1=0;
+	for(int32_t i=0;i<anz;i++) {
+		JointPlane& p=planes[i];
+		p.rows=NULL;
+		p.outcome=JOINT_NOGRAY;
+		p.contains=0;
+		if (p.active <= 0) continue;
+		
+		Root& c=*p.cycle;
+		p.all.x0=p.all.y0=(int32_t)(SCREENWIDTH-1);
+		p.all.x1=p.all.y1=0;
+		for(int32_t k=0;k<c.cyclelen;k++) {
+			int32_t xx=scrcoord_as_lowerleft((T)c.cycle[k].pp.re,scalePixelPerRange);
+			int32_t yy=scrcoord_as_lowerleft((T)c.cycle[k].pp.im,scalePixelPerRange);
+			ScreenRect scr;
+			scr.x0=xx-encw;
+			scr.x1=xx+encw;
+			scr.y0=yy-encw;
+			scr.y1=yy+encw;
+			TRIM(scr.x0)
+			TRIM(scr.x1)
+			TRIM(scr.y0)
+			TRIM(scr.y1)
+			if (scr.x0 < p.all.x0) p.all.x0=scr.x0;
+			if (scr.x1 > p.all.x1) p.all.x1=scr.x1;
+			if (scr.y0 < p.all.y0) p.all.y0=scr.y0;
+			if (scr.y1 > p.all.y1) p.all.y1=scr.y1;
+			c.cycle[k].mem0=scr.x0 >> SHIFTPERDDBYTE;
+			c.cycle[k].mem1=scr.x1 >> SHIFTPERDDBYTE;
+			c.cycle[k].y0=scr.y0;
+			c.cycle[k].y1=scr.y1;
+		}
+		
+		local[i].x0=p.all.x0*scaleRangePerPixel + NC::COMPLETE0;
+		local[i].x1=(p.all.x1+1)*scaleRangePerPixel + NC::COMPLETE0;
+		local[i].y0=p.all.y0*scaleRangePerPixel + NC::COMPLETE0;
+		local[i].y1=(p.all.y1+1)*scaleRangePerPixel + NC::COMPLETE0;
+		c.ps_basinrect.x0=(NTYP)local[i].x0;
+		c.ps_basinrect.x1=(NTYP)local[i].x1;
+		c.ps_basinrect.y0=(NTYP)local[i].y0;
+		c.ps_basinrect.y1=(NTYP)local[i].y1;
+		c.encw=encw;
+		
+		if (p.all.x0 < U.x0) U.x0=p.all.x0;
+		if (p.all.x1 > U.x1) U.x1=p.all.x1;
+		if (p.all.y0 < U.y0) U.y0=p.all.y0;
+		if (p.all.y1 > U.y1) U.y1=p.all.y1;
+	}
+	
+	const int32_t memU0=U.x0 >> SHIFTPERDDBYTE;
+	const int32_t memU1=U.x1 >> SHIFTPERDDBYTE;
+	// the grid of the union, it contains every local[i]
+	CmGrid<T> grid;
+	grid.local.x0=U.x0*scaleRangePerPixel + NC::COMPLETE0;
+	grid.local.x1=(U.x1+1)*scaleRangePerPixel + NC::COMPLETE0;
+	grid.local.y0=U.y0*scaleRangePerPixel + NC::COMPLETE0;
+	grid.local.y1=(U.y1+1)*scaleRangePerPixel + NC::COMPLETE0;
+	grid.scaleRangePerPixel=scaleRangePerPixel;
+	grid.scalePixelPerRange=scalePixelPerRange;
+	grid.mixed=0;
+	grid.nexact=NULL;
+	const int32_t LENX=memU1-memU0+1;
+	const int32_t LENY=U.y1-U.y0+1;
+	
+	// rows intersecting an enclosement of the cycle: its words
+	// startwith, the enclosements gray
+	int64_t bitmapbytes=0;
+	for(int32_t i=0;i<anz;i++) {
+		JointPlane& p=planes[i];
+		if (p.active <= 0) continue;
+		
+		Root& c=*p.cycle;
+		const int32_t mem0=p.all.x0 >> SHIFTPERDDBYTE;
+		const int32_t mem1=p.all.x1 >> SHIFTPERDDBYTE;
+		p.rows=new PDDBYTE[LENY];
+		for(int32_t y=0;y<LENY;y++) p.rows[y]=NULL;
+		for(int32_t k=0;k<c.cyclelen;k++) {
+			for(int32_t y=c.cycle[k].y0;y<=c.cycle[k].y1;y++) {
+				PDDBYTE& row=p.rows[y-U.y0];
+				if (!row) {
+					row=new DDBYTE[LENX];
+					if (!row) {
+						LOGMSG("Memory error. joint\n");
+						fail();
+					}
+					bitmapbytes += (int64_t)LENX*sizeof(DDBYTE);
+					for(int32_t m=0;m<LENX;m++) {
+						row[m]=( ( (m+memU0) >= mem0) && ( (m+memU0) <= mem1) ) ? startwith : ALL32POTW;
+					}
+				}
+			}
+		}
+		for(int32_t k=0;k<c.cyclelen;k++) {
+			for(int32_t y=c.cycle[k].y0;y<=c.cycle[k].y1;y++) {
+				for(int32_t m=c.cycle[k].mem0;m<=c.cycle[k].mem1;m++) {
+					p.rows[y-U.y0][m-memU0]=ALL32GRAY;
+				}
+			}
+		}
+	}
+	printfootprint(task,bitmapbytes);
+	cmprintf(task," analyzing ");
+	
+	// RECT_HITS_POTW on plane i
+	auto hitspotw=[&](const int32_t i,const ScreenRect& scr) {
+		const JointPlane& p=planes[i];
+		if ( (scr.x0 > scr.x1) || (scr.y0 > scr.y1) ) return (int8_t)0;
+		if ( (scr.x0 < p.all.x0) || (scr.x1 > p.all.x1) || (scr.y0 < p.all.y0) || (scr.y1 > p.all.y1) ) return (int8_t)1;
+		
+		int32_t bm0=(scr.x0 >> SHIFTPERDDBYTE)-memU0;
+		int32_t bm1=(scr.x1 >> SHIFTPERDDBYTE)-memU0;
+		DDBYTE mask0=ALL32POTW << (scr.x0 & ((1 << SHIFTPERDDBYTE)-1));
+		DDBYTE mask1=ALL32POTW >> ( ((1 << SHIFTPERDDBYTE)-1) - (scr.x1 & ((1 << SHIFTPERDDBYTE)-1)) );
+		if (bm0 == bm1) {
+			mask0 &= mask1;
+			mask1=mask0;
+		}
+		for(int32_t by=scr.y0;by<=scr.y1;by++) {
+			PDDBYTE brow=p.rows[by-U.y0];
+			if (
+				(!brow) ||
+				(ATOMIC_LOAD32(&brow[bm0]) & mask0) ||
+				(ATOMIC_LOAD32(&brow[bm1]) & mask1)
+			) {
+				return (int8_t)1;
+			}
+			for(int32_t bm=bm0+1;bm<bm1;bm++) {
+				if (ATOMIC_LOAD32(&brow[bm]) != ALL32GRAY) return (int8_t)1;
+			}
+		}
+		return (int8_t)0;
+	};
+	
+	// a plane without change in a sweep is at its fixed point
+	// and not swept any more
+	std::atomic<int32_t> planechanged[MAXJOINT];
+	int8_t sweeping[MAXJOINT];
+	for(int32_t i=0;i<anz;i++) sweeping[i]=(planes[i].rows != NULL);
+	auto sweeprow=[&](const int32_t y) {
+		const int32_t yi=y-U.y0;
+		PlaneRectT<T> A,bbxfA;
+		A.y0=y*scaleRangePerPixel + NC::COMPLETE0;
+		A.y1=A.y0+scaleRangePerPixel;
+		DDBYTE ff[MAXJOINT],fneu[MAXJOINT];
+		// only the words of the planes with memory in this row
+		int32_t rm0=memU1+1,rm1=memU0-1;
+		for(int32_t i=0;i<anz;i++) {
+			if ( (sweeping[i] <= 0) || (!planes[i].rows[yi]) ) continue;
+			if ( (planes[i].all.x0 >> SHIFTPERDDBYTE) < rm0) rm0=planes[i].all.x0 >> SHIFTPERDDBYTE;
+			if ( (planes[i].all.x1 >> SHIFTPERDDBYTE) > rm1) rm1=planes[i].all.x1 >> SHIFTPERDDBYTE;
+		}
+		for(int32_t m=rm0;m<=rm1;m++) {
+			DDBYTE gray=0;
+			for(int32_t i=0;i<anz;i++) {
+				ff[i]=ALL32POTW;
+				fneu[i]=0;
+				if ( (sweeping[i] > 0) && (planes[i].rows[yi]) ) ff[i]=ATOMIC_LOAD32(&planes[i].rows[yi][m-memU0]);
+				gray |= ~ff[i];
+			}
+			if (gray == 0) continue;
+			
+			// screen rectangles against the union, in batches if
+			// the type has a word kernel
+			ScreenRect scr[32];
+			DDBYTE inside=0;
+			if (wordkernel(grid,A,m << SHIFTPERDDBYTE,gray,scr,inside) <= 0) {
+				for(int32_t bit=0;bit<32;bit++) {
+					if ( ((gray >> bit) & 0b1) == 0) continue;
+					
+					int xc=(m << SHIFTPERDDBYTE)+bit;
+					A.x0=xc*scaleRangePerPixel + NC::COMPLETE0;
+					A.x1=A.x0+scaleRangePerPixel;
+					if (getScreenRectfA(grid,A,scr[bit]) > 0) inside |= ((DDBYTE)1 << bit);
+				}
+			}
+			
+			for(int32_t bit=0;bit<32;bit++) {
+				if ( ((gray >> bit) & 0b1) == 0) continue;
+				
+				for(int32_t i=0;i<anz;i++) {
+					if ( (ff[i] >> bit) & 0b1) continue;
+					int8_t hit=1;
+					if ( (inside >> bit) & 0b1) {
+						const ScreenRect& pa=planes[i].all;
+						const ScreenRect& r=scr[bit];
+						if ( (r.x0 > pa.x0) && (r.x1 < pa.x1) && (r.y0 > pa.y0) && (r.y1 < pa.y1) ) {
+							// a pixel off the edges: the bounding box lies in local[i]
+							hit=hitspotw(i,r);
+						} else if ( (r.x0 >= pa.x0) && (r.x1 <= pa.x1) && (r.y0 >= pa.y0) && (r.y1 <= pa.y1) ) {
+							// on an edge: local[i] decides as in cm_local
+							int xc=(m << SHIFTPERDDBYTE)+bit;
+							A.x0=xc*scaleRangePerPixel + NC::COMPLETE0;
+							A.x1=A.x0+scaleRangePerPixel;
+							NC::getBoundingBoxfA(A,bbxfA);
+							if (SQUARE_LIES_ENTIRELY_IN_LOCAL(bbxfA,local[i]) > 0) hit=hitspotw(i,r);
+						}
+						// beyond an edge: hit in any case
+					}
+					if (hit > 0) fneu[i] |= ((DDBYTE)1 << bit);
+				}
+			} // bit
+			
+			for(int32_t i=0;i<anz;i++) {
+				if (fneu[i] == 0) continue;
+				ATOMIC_OR32(&planes[i].rows[yi][m-memU0],fneu[i]);
+				planechanged[i].store(1,std::memory_order_relaxed);
+			}
+		} // m
+	};
+	
+	int32_t changed=1;
+	while (changed > 0) {
+		for(int32_t i=0;i<anz;i++) planechanged[i].store(0);
+		parallel_rows(task.threads,U.y0,U.y1,sweeprow);
+		changed=0;
+		for(int32_t i=0;i<anz;i++) {
+			if (planechanged[i].load() > 0) changed=1;
+			else sweeping[i]=0;
+		}
+		cmprintf(task,".");
+	}
+	
+	// outcome: gray cells left, and whose periodic points they contain
+	for(int32_t i=0;i<anz;i++) {
+		JointPlane& p=planes[i];
+		if (p.active <= 0) continue;
+		
+		int8_t graythere=0;
+		for(int32_t y=0;(y<LENY) && (graythere<=0);y++) {
+			if (!p.rows[y]) continue;
+			for(int32_t m=0;m<LENX;m++) {
+				if (p.rows[y][m] != ALL32POTW) {
+					graythere=1;
+					break;
+				}
+			}
+		}
+		if (graythere <= 0) continue;
+		
+		for(int32_t j=0;j<anz;j++) {
+			Root& c=*planes[j].cycle;
+			for(int32_t k=0;k<c.cyclelen;k++) {
+				int32_t xx=scrcoord_as_lowerleft((T)c.cycle[k].pp.re,scalePixelPerRange);
+				int32_t yy=scrcoord_as_lowerleft((T)c.cycle[k].pp.im,scalePixelPerRange);
+				if ( (yy < U.y0) || (yy > U.y1) || (xx < (memU0 << SHIFTPERDDBYTE)) || (xx > ((memU1+1) << SHIFTPERDDBYTE)-1) ) continue;
+				PDDBYTE row=p.rows[yy-U.y0];
+				if ( (row) && ( ((row[(xx >> SHIFTPERDDBYTE)-memU0] >> (xx & ((1 << SHIFTPERDDBYTE)-1))) & 0b1) == SQUARE_GRAY) ) {
+					p.contains |= ((uint32_t)1 << j);
+					break;
+				}
+			}
+		}
+		if ( (p.contains >> i) & 0b1) p.outcome=JOINT_OWN;
+		else if (p.contains != 0) p.outcome=JOINT_OTHER;
+		else p.outcome=JOINT_NONE;
+	}
+	
+	for(int32_t i=0;i<anz;i++) {
+		if (!planes[i].rows) continue;
+		for(int32_t y=0;y<LENY;y++) {
+			if (planes[i].rows[y]) delete[] planes[i].rows[y];
+		}
+		delete[] planes[i].rows;
+		planes[i].rows=NULL;
+	}
+}
+
+// JOINT=1: levels LEVEL0..LEVEL1 for all cycles acycles[0..anz-1] until
+// each has black of its own. Black of plane i in gray cells that contain
+// only periodic points of other cycles is attributed to those, the level
+// search for cycle i goes on. Without any periodic point in the gray
+// cells the level counts for the cycle as in cm_local
+void cm_joint(Root** acycles,const int32_t anz,const DDBYTE startwith,CmTask& task) {
+	JointPlane planes[MAXJOINT];
+	for(int32_t i=0;i<anz;i++) {
+		planes[i].cycle=acycles[i];
+		planes[i].active=1;
+		planes[i].rows=NULL;
+		acycles[i]->interiorfound=0;
+		acycles[i]->seconds=0.0;
+	}
+	
+	int32_t anzactive=anz;
+	for(int32_t level=LEVEL0;(level<=LEVEL1) && (anzactive>0);level++) {
+		double t0=wallseconds();
+		cmprintf(task,"\nchecking level %i (%i cycles)",level,anzactive);
+		switch (levelprecision(level)) {
+			case PRECISION_LD: cm_joint_T<long double>(planes,anz,startwith,task,level); break;
+			case PRECISION_QD: cm_joint_T<__float128>(planes,anz,startwith,task,level); break;
+			case PRECISION_DY128: cm_joint_T<Dyadic128>(planes,anz,startwith,task,level); break;
+			case PRECISION_DY192: cm_joint_T<Dyadic192>(planes,anz,startwith,task,level); break;
+			case PRECISION_DY256: cm_joint_T<Dyadic256>(planes,anz,startwith,task,level); break;
+			case PRECISION_DD: cm_joint_T<DoubleDouble>(planes,anz,startwith,task,level); break;
+			default: cm_joint_T<double>(planes,anz,startwith,task,level); break;
+		}
+		
+		for(int32_t i=0;i<anz;i++) {
+			JointPlane& p=planes[i];
+			if ( (p.active <= 0) || (p.outcome == JOINT_NOGRAY) ) continue;
+			
+			cmprintf(task,"\n  cycle #%i: black",p.cycle->cyclenumber);
+			if (p.outcome == JOINT_NONE) cmprintf(task," (no periodic point in it)");
+			else if (p.outcome == JOINT_OTHER) cmprintf(task," only at periodic points of");
+			else if (p.contains != ((uint32_t)1 << i)) cmprintf(task,", also at periodic points of");
+			for(int32_t j=0;j<anz;j++) {
+				if ( (j != i) && ((p.contains >> j) & 0b1) ) cmprintf(task," #%i",planes[j].cycle->cyclenumber);
+			}
+			if (p.outcome == JOINT_OTHER) {
+				cmprintf(task,", not counted");
+				continue;
+			}
+			
+			p.active=0;
+			p.cycle->interiorfound=level;
+			anzactive--;
+		}
+		
+		for(int32_t i=0;i<anz;i++) {
+			if ( (planes[i].active > 0) || (planes[i].cycle->interiorfound == level) ) {
+				planes[i].cycle->seconds += wallseconds()-t0;
+			}
+		}
+	}
+}
+
+// struct Root
+
+void Root::clear(void) {
+	cyclelen=0;
+	cycle=NULL;
+	interiorfound=0;
+	multiplier=0.0;
+	encw=0;
+	continuelevel=0;
+	metrics=NULL;
+	anzmetrics=0;
+	seconds=0.0;
+}
+
+// standard values of all parameters
+void setdefaults(void) {
+	_FUNC=FUNC_Z2C;
+	_DEGREE=0;
+	for(int32_t k=PRECISION_D;k<=PRECISION_QD;k++) {
+		if (!strcmp(precisionname[k],NNTYPSTR)) _PRECISION=k;
+	}
+	COMPLETE0=-2;
+	COMPLETE1=2;
+	seedC0re=seedC1re=floor(-1.0*DENOM225) / DENOM225; 
+	seedC0im=seedC1im=floor(0.0*DENOM225) / DENOM225; 
+	FAKTORAre=FAKTORAim=0.0;
+	_ENCLOSEMENTWIDTH=128;
+	_ENCWAUTO=0;
+	LEVEL0=10;
+	LEVEL1=24;
+	_STARTWITH=ALL32POTW;
+	_PROPAGATION=PROPAGATION_SWEEP;
+	_INCREMENTAL=0;
+	_MIXED=0;
+	_JOINT=0;
+	_SEARCH=SEARCH_LINEAR;
+	_CRITICAL=CRITICAL_AUTO;
+	_SIMD=SIMD_AUTO;
+	_MEMLIMIT=0;
+	_BITMAP=BITMAP_ROWS;
+	THREADS=1;
+	PERIODICLEN0=PERIODICLEN1=-1;
+}
+
+// one parameter of the command line or a BATCH line,
+// returns 0 if it is not known
+int8_t parseparam(char* arg) {
+	// file names keep their case
+	char original[1024];
+	strncpy(original,arg,sizeof(original)-1);
+	original[sizeof(original)-1]=0;
+	upper(arg);
+	
+	if (strstr(arg,"FUNC=")==arg) {
+		_FUNC=getfuncidx(&arg[5]);
+		if (_FUNC < 0) _FUNC=FUNC_Z2C;
+	} else if (strstr(arg,"C=")==arg) {
+		double r0,i0; // not NTYP
+		// command line parameters are always considered double no matter the datatype used
+		if (sscanf(&arg[2],"%lf,%lf",&r0,&i0) == 2) {
+			seedC0re=seedC1re=floor(r0*DENOM225)/DENOM225;
+			seedC0im=seedC1im=floor(i0*DENOM225)/DENOM225;
+		}
+	} else if (strstr(arg,"A=")==arg) {
+		double r0,i0;
+		if (sscanf(&arg[2],"%lf,%lf",&r0,&i0) == 2) {
+			FAKTORAre=floor(r0*DENOM225)/DENOM225;
+			FAKTORAim=floor(i0*DENOM225)/DENOM225;
+		}
+	} else if (strstr(arg,"ENCW=AUTO")==arg) {
+		// ENCW=AUTO,n: n the largest width, its sign as for ENCW
+		_ENCWAUTO=1;
+		int32_t a;
+		if (sscanf(&arg[9],",%i",&a) == 1) {
+			if (a < 0) {
+				a=-a;
+				_STARTWITH=ALL32GRAY;
+			} else {
+				_STARTWITH=ALL32POTW; 
+			}
+			_ENCLOSEMENTWIDTH=a;
+		} else {
+			_ENCLOSEMENTWIDTH=512;
+		}
+	} else if (strstr(arg,"ENCW=")==arg) {
+		_ENCWAUTO=0;
+		int32_t a;
+		if (sscanf(&arg[5],"%i",&a) == 1) {
+			if (a < 0) {
+				a=-a;
+				_STARTWITH=ALL32GRAY; // all gray, i.e. to analyze
+			} else {
+				_STARTWITH=ALL32POTW; 
+			}
+			_ENCLOSEMENTWIDTH=a;
+		}
+	} else if (strstr(arg,"LEVEL=")==arg) {
+		int32_t a,b;
+		if (sscanf(&arg[6],"%i,%i",&a,&b) == 2) {
+			LEVEL0=a;
+			LEVEL1=b;
+		}
+	} else if (strstr(arg,"PROPAGATION=")==arg) {
+		if (!strcmp(&arg[12],"WORKLIST")) _PROPAGATION=PROPAGATION_WORKLIST;
+		else _PROPAGATION=PROPAGATION_SWEEP;
+	} else if (strstr(arg,"INCREMENTAL=")==arg) {
+		int32_t a;
+		if (sscanf(&arg[12],"%i",&a) == 1) {
+			_INCREMENTAL=a;
+		}
+	} else if (strstr(arg,"JOINT=")==arg) {
+		int32_t a;
+		if (sscanf(&arg[6],"%i",&a) == 1) {
+			_JOINT=a;
+		}
+	} else if (strstr(arg,"MIXED=")==arg) {
+		int32_t a;
+		if (sscanf(&arg[6],"%i",&a) == 1) {
+			_MIXED=a;
+		}
+	} else if (strstr(arg,"SEARCH=")==arg) {
+		if (!strcmp(&arg[7],"GALLOP")) _SEARCH=SEARCH_GALLOP;
+		else if (!strcmp(&arg[7],"PREDICT")) _SEARCH=SEARCH_PREDICT;
+		else _SEARCH=SEARCH_LINEAR;
+	} else if (strstr(arg,"CRITICAL=")==arg) {
+		if (!strcmp(&arg[9],"ABERTH")) _CRITICAL=CRITICAL_ABERTH;
+		else if (!strcmp(&arg[9],"SCAN")) _CRITICAL=CRITICAL_SCAN;
+		else _CRITICAL=CRITICAL_AUTO;
+	} else if (strstr(arg,"SIMD=")==arg) {
+		if (!strcmp(&arg[5],"OFF")) _SIMD=SIMD_OFF;
+		else if (!strcmp(&arg[5],"GENERIC")) _SIMD=SIMD_GENERIC;
+		else if (!strcmp(&arg[5],"AVX2")) _SIMD=SIMD_AVX2;
+		else if (!strcmp(&arg[5],"AVX512")) _SIMD=SIMD_AVX512;
+		else _SIMD=SIMD_AUTO;
+	} else if (strstr(arg,"MEMLIMIT=")==arg) {
+		int32_t a;
+		if (sscanf(&arg[9],"%i",&a) == 1) {
+			if (a < 0) a=0;
+			_MEMLIMIT=(int64_t)a << 20;
+		}
+	} else if (strstr(arg,"BITMAP=")==arg) {
+		if (!strcmp(&arg[7],"TILES")) _BITMAP=BITMAP_TILES;
+		else _BITMAP=BITMAP_ROWS;
+	} else if (strstr(arg,"PRECISION=")==arg) {
+		if (!strcmp(&arg[10],"D")) _PRECISION=PRECISION_D;
+		else if (!strcmp(&arg[10],"LD")) _PRECISION=PRECISION_LD;
+		else if (!strcmp(&arg[10],"QD")) _PRECISION=PRECISION_QD;
+		else if (!strcmp(&arg[10],"AUTO")) _PRECISION=PRECISION_AUTO;
+		else if (!strcmp(&arg[10],"DY")) _PRECISION=PRECISION_DY;
+		else if (!strcmp(&arg[10],"DD")) _PRECISION=PRECISION_DD;
+	} else if (strstr(arg,"THREADS=")==arg) {
+		int32_t a;
+		if (sscanf(&arg[8],"%i",&a) == 1) {
+			if (a <= 0) a=std::thread::hardware_concurrency();
+			if (a < 1) a=1;
+			THREADS=a;
+		}
+	} else if (strstr(arg,"PERIODS=")==arg) {
+		int32_t a,b;
+		if (sscanf(&arg[8],"%i,%i",&a,&b) == 2) {
+			PERIODICLEN0=a;
+			PERIODICLEN1=b;
+		}
+	} else if (strstr(arg,"BATCHOUT=")==arg) {
+		strcpy(_BATCHOUT,&original[9]);
+	} else if (strstr(arg,"BATCHFORMAT=")==arg) {
+		if (!strcmp(&arg[12],"JSONL")) _BATCHFORMAT=BATCHFORMAT_JSONL;
+		else _BATCHFORMAT=BATCHFORMAT_CSV;
+	} else if (strstr(arg,"BATCH=")==arg) {
+		strcpy(_BATCHFILE,&original[6]);
+	} else if (strstr(arg,"CHECKPOINT=")==arg) {
+		strcpy(_CHECKPOINTFILE,&original[11]);
+		char* komma=strrchr(_CHECKPOINTFILE,',');
+		if (komma) {
+			int32_t a;
+			if ( (sscanf(komma+1,"%i",&a) == 1) && (a > 0) ) _CHECKPOINTSECONDS=a;
+			*komma=0;
+		}
+	} else if (strstr(arg,"RESUME=")==arg) {
+		strcpy(_RESUMEFILE,&original[7]);
+	} else if (strstr(arg,"CACHE=")==arg) {
+		strcpy(_CACHEFILE,&original[6]);
+	} else if (strstr(arg,"METRICS=")==arg) {
+		strcpy(_METRICSFILE,&original[8]);
+	} else if (strstr(arg,"EXPORT=")==arg) {
+		strcpy(_EXPORTFILE,&original[7]);
+	} else if (strstr(arg,"SWEEP=")==arg) {
+		SweepGrid g;
+		if (sscanf(&arg[6],"%lf,%lf,%lf,%lf,%i,%i",&g.re0,&g.re1,&g.im0,&g.im1,&g.nre,&g.nim) == 6) {
+			_SWEEPC=g;
+		}
+	} else if (strstr(arg,"SWEEPA=")==arg) {
+		SweepGrid g;
+		if (sscanf(&arg[7],"%lf,%lf,%lf,%lf,%i,%i",&g.re0,&g.re1,&g.im0,&g.im1,&g.nre,&g.nim) == 6) {
+			_SWEEPA=g;
+		}
+	} else if (strstr(arg,"BENCH=")==arg) {
+		int32_t a;
+		if ( (sscanf(&arg[6],"%i",&a) == 1) && (a > 0) ) _BENCH=a;
+	} else if (strstr(arg,"CONTINUE=")==arg) {
+		int32_t a;
+		if (sscanf(&arg[9],"%i",&a) == 1) {
+			_CONTINUE=(a < 0 ? -1 : a);
+		}
+	} else if (strstr(arg,"SHARD=")==arg) {
+		int32_t a,b;
+		if (sscanf(&arg[6],"%i/%i",&a,&b) == 2) {
+			_SHARD=a;
+			_SHARDS=b;
+		}
+	} else {
+		return 0;
+	}
+	
+	return 1;
+}
+
+// polynomial, kernels and complete square from the parameters
+void setupparams(void) {
+	cplxC=Complex(seedC0re,seedC0im);
+	cplxA=Complex(FAKTORAre,FAKTORAim);
+	
+	if (LEVEL0<8) LEVEL0=8;
+	if (LEVEL1>31) LEVEL1=31;
+
+	// setting function pointers
+	_SIMD=getsimd(_SIMD);
+	setfunc(_FUNC);
+	
+	if (_BITMAP==BITMAP_TILES) {
+		// worklist and incremental order index the whole
+		// enclosement rows
+		_PROPAGATION=PROPAGATION_SWEEP;
+		_INCREMENTAL=0;
+	}
+	#ifndef _MMAPAVAILABLE
+	_MEMLIMIT=0;
+	#endif
+	
+	// must be AFTER setfunc
+	// enclosement for filled-in Julia set is computed
+	COMPLETE1=getLagrange(fkt);
+	COMPLETE0=-COMPLETE1;
+	setnumcore<double>();
+	setnumcore<long double>();
+	setnumcore<__float128>();
+	setdyadic();
+	setnumcore<Dyadic128>();
+	setnumcore<Dyadic192>();
+	setnumcore<Dyadic256>();
+	setnumcore<DoubleDouble>();
+}
+
+// cycle of zero[cp] is attracting and to be analyzed (PERIODS)
+int8_t cycleselected(const int32_t cp) {
+	if (zero[cp].cyclelen<=0) return 0;
+	if (
+		(PERIODICLEN0>0)
+		&& ( !(
+			(PERIODICLEN0 <= zero[cp].cyclelen) &&
+			(zero[cp].cyclelen <= PERIODICLEN1)
+		) )
+	) {
+		return 0;
+	}
+	
+	return 1;
+}
+
+// do the enclosements of different cycles overlap
+// if so: detected black for a given cycle might
+// have actually detected another (earlier emerging) one
+// only valid if all cycles are actually analyzed (PERIODS command-line)
+int8_t cyclesoverlap(void) {
+	for(int32_t i=0;i<nbr_of_cp;i++) {
+		if (
+			(zero[i].cyclelen <= 0) ||
+			(zero[i].interiorfound <= 0) 
+		) continue;
+		
+		for(int32_t k=0;k<nbr_of_cp;k++) {
+			if (
+				(i==k) ||
+				(zero[k].cyclelen <= 0) ||
+				(zero[k].interiorfound <= 0) 
+			) continue;
+			
+			// does enclosement i overlap with k
+			if (
+				(zero[i].ps_basinrect.x1 < zero[k].ps_basinrect.x0) ||
+				(zero[i].ps_basinrect.x0 > zero[k].ps_basinrect.x1) ||
+				(zero[i].ps_basinrect.y1 < zero[k].ps_basinrect.y0) ||
+				(zero[i].ps_basinrect.y0 > zero[k].ps_basinrect.y1)
+			) {
+			} else {
+				return 1;
+			}
+		} // k
+	}
+	
+	return 0;
+}
+
+// function name in the result records, lower case
+void recordfuncname(char* fn) {
+	if (_FUNC == FUNC_ZNAZC) sprintf(fn,"z%iazc",_DEGREE);
+	else {
+		strcpy(fn,funcname[_FUNC]);
+		for(int32_t i=0;fn[i];i++) {
+			if ((fn[i]>='A')&&(fn[i]<='Z')) fn[i]=fn[i]-'A'+'a';
+		}
+	}
+}
+
+// one result record of BATCH/SWEEP: cycle zero[cp], or cp < 0 if
+// no attracting cycle was analyzed for that parameter set.
+// apt: grid position of a SWEEP point, NULL for BATCH
+void batchrecord(TextBuffer& buf,const int32_t alinenr,const SweepPoint* apt,const int32_t cp,const int8_t aoverlap) {
+	char fn[16];
+	recordfuncname(fn);
+	int32_t encw=_ENCLOSEMENTWIDTH;
+	// ENCW=AUTO: the width black was found with
+	if ( (_ENCWAUTO > 0) && (cp >= 0) && (zero[cp].encw > 0) ) encw=zero[cp].encw;
+	if (_STARTWITH == ALL32GRAY) encw=-encw;
+	int32_t cyclenumber=0,period=0,level=0;
+	double multiplier=0.0;
+	const char* prec="";
+	const char* status="nocycle";
+	if (cp >= 0) {
+		cyclenumber=zero[cp].cyclenumber;
+		period=zero[cp].cyclelen;
+		multiplier=zero[cp].multiplier;
+		level=zero[cp].interiorfound;
+		if (level > 0) {
+			prec=precisionname[levelprecision(level)];
+			status="black";
+		} else {
+			status="noblack";
+		}
+	}
+	
+	if (_BATCHFORMAT == BATCHFORMAT_JSONL) {
+		if (apt) {
+			buf.append("{\"point\":%lld,\"ix\":%i,\"iy\":%i,\"ia\":%i,",(long long)apt->idx,apt->ix,apt->iy,apt->ia);
+		} else {
+			buf.append("{");
+		}
+		buf.append("\"line\":%i,\"func\":\"%s\",\"c\":[%.20lg,%.20lg],\"a\":[%.20lg,%.20lg],\"encw\":%i,\"levels\":[%i,%i],"
+			"\"cycle\":%i,\"period\":%i,\"multiplier\":%.10lg,\"level\":%i,\"precision\":\"%s\",\"overlap\":%i,\"status\":\"%s\"}\n",
+			alinenr,fn,(double)seedC0re,(double)seedC0im,(double)FAKTORAre,(double)FAKTORAim,encw,LEVEL0,LEVEL1,
+			cyclenumber,period,multiplier,level,prec,aoverlap,status);
+	} else {
+		if (apt) {
+			buf.append("%lld,%i,%i,%i,",(long long)apt->idx,apt->ix,apt->iy,apt->ia);
 		}
+		buf.append("%i,%s,%.20lg,%.20lg,%.20lg,%.20lg,%i,%i,%i,%i,%i,%.10lg,%i,%s,%i,%s\n",
+			alinenr,fn,(double)seedC0re,(double)seedC0im,(double)FAKTORAre,(double)FAKTORAim,encw,LEVEL0,LEVEL1,
+			cyclenumber,period,multiplier,level,prec,aoverlap,status);
 	}
-	fprintf(f,"\n");
 }
 
-void Polynom::eval_arg_f(const Complex az,Complex& erg) {
-	erg=coeff[grad];
+// METRICS=file: one JSON line per parameter set with the wall time
+// of its phases and the counters of every level of every cycle
+// analyzed. alinenr=0: command line
+void metricsrecord(const int32_t alinenr,const SweepPoint* apt,const double acritical,const double aorbits,const double atotal) {
+	if (!metricsfile) return;
 	
-	for(int32_t i=grad;i>0;i--) {
-		erg = erg*az;
-		erg = erg + coeff[i-1];
+	char fn[16];
+	recordfuncname(fn);
+	TextBuffer buf;
+	if (apt) {
+		buf.append("{\"point\":%lld,\"ix\":%i,\"iy\":%i,\"ia\":%i,",(long long)apt->idx,apt->ix,apt->iy,apt->ia);
+	} else {
+		buf.append("{");
 	}
+	buf.append("\"line\":%i,\"func\":\"%s\",\"c\":[%.20lg,%.20lg],\"a\":[%.20lg,%.20lg],\"encw\":%i,\"threads\":%i,"
+		"\"seconds\":{\"criticalpoints\":%.6lf,\"orbits\":%.6lf,\"total\":%.6lf},\"cycles\":[",
+		alinenr,fn,(double)seedC0re,(double)seedC0im,(double)FAKTORAre,(double)FAKTORAim,
+		(_STARTWITH == ALL32GRAY ? -_ENCLOSEMENTWIDTH : _ENCLOSEMENTWIDTH),THREADS,
+		acritical,aorbits,atotal);
+	int8_t first=1;
+	for(int32_t cp=0;cp<nbr_of_cp;cp++) {
+		if (cycleselected(cp) <= 0) continue;
+		
+		Root& r=zero[cp];
+		buf.append("%s{\"cycle\":%i,\"period\":%i,\"multiplier\":%.10lg,\"level\":%i,\"seconds\":%.6lf,\"levels\":[",
+			(first > 0 ? "" : ","),r.cyclenumber,r.cyclelen,r.multiplier,r.interiorfound,r.seconds);
+		first=0;
+		for(int32_t i=0;i<r.anzmetrics;i++) {
+			LevelMetrics& lm=r.metrics[i];
+			buf.append("%s{\"level\":%i,\"encw\":%i,\"precision\":\"%s\",\"source\":\"%s\",\"black\":%i,"
+				"\"passes\":%i,\"cells\":%lld,\"bbx\":%lld,\"exact\":%lld,\"pixels\":%lld,\"bitmapbytes\":%lld,\"allocatedbytes\":%lld,\"seconds\":%.6lf}",
+				(i > 0 ? "," : ""),lm.level,lm.encw,precisionname[lm.prec],levelsourcename[lm.source],lm.black,
+				lm.passes,(long long)lm.cells,(long long)lm.bbx,(long long)lm.exact,(long long)lm.pixels,
+				(long long)lm.footprint,(long long)lm.bytes,lm.seconds);
+		}
+		buf.append("]}");
+	}
+	buf.append("]}\n");
+	
+	// unbuffered: SWEEP workers append whole lines
+	fputs(buf.text,metricsfile);
 }
 
-Polynom::Polynom() {
-	grad=0;
-	clearCoeff();
-}
-
-void Polynom::setCoeff(const int32_t aidx,const NTYP ar,const NTYP ai) {
-	setCoeff(aidx,Complex(ar,ai));
+void batchheader(FILE* f,const int8_t asweep) {
+	if (_BATCHFORMAT != BATCHFORMAT_CSV) return;
+	
+	if (asweep > 0) fprintf(f,"point,ix,iy,ia,");
+	fprintf(f,"line,func,c_re,c_im,a_re,a_im,encw,level0,level1,cycle,period,multiplier,level,precision,overlap,status\n");
 }
 
-int cm_local(Root& onecycle,const DDBYTE startwith) {
-	// a bounding box for ALL cyclic points
-	// small rectangles around every cyclic point
-	ScreenRect enclosementall;
+// the parameters set up: all cycles are analyzed and their
+// records appended to buf, returns the number of records
+int32_t batchanalyze(CmTask& task,TextBuffer& buf,const int32_t alinenr,const SweepPoint* apt) {
+	// cycles of the previous parameter set
+	for(int32_t i=0;i<MAXZEROS;i++) {
+		if (zero[i].cycle) delete[] zero[i].cycle;
+		if (zero[i].metrics) delete[] zero[i].metrics;
+		zero[i].clear();
+	}
 	
-	ArrayDDByteManager mgr;
-	PDDBYTE *ispotwY=NULL;
+	double t0=wallseconds();
+	ps_find_critical_points();
+	double t1=wallseconds();
+	int32_t anzcycles=0;
+	if (nbr_of_cp > 0) anzcycles=ps_construct_critical_orbits();
+	if (anzcycles <= 0) nbr_of_cp=0;
+	double t2=wallseconds();
 	
-	#define SET32_MY(MM,YY,FF32) \
-	{\
-		if (\
-			( (MM) >= mem0 ) &&\
-			( (MM) <= mem1 ) &&\
-			( (YY) >= enclosementall.y0 ) &&\
-			( (YY) <= enclosementall.y1 ) \
-		) {\
-			if (ispotwY[ (YY)-enclosementall.y0 ]) {\
-				ispotwY[ (YY)-enclosementall.y0 ][MM-mem0] = FF32;\
-			} else {\
-				LOGMSG4("Error/mil. Set32 %i,%i,%i\n",MM,YY,FF32);\
-				exit(99);\
-			}\
-		} else {\
-			LOGMSG4("Error. Set32 %i,%i,%i\n",MM,YY,FF32);\
-			exit(99);\
-		}\
+	int32_t anzanalyzed=0;
+	for(int32_t cp=0;cp<nbr_of_cp;cp++) {
+		if (cycleselected(cp) <= 0) continue;
+		task.out->clear();
+		cm_local(zero[cp],_STARTWITH,task);
+		anzanalyzed++;
 	}
 	
-	#define GET32_MY(MM,YY,ERG32) \
-	{\
-		ERG32=ALL32POTW;\
-		if (\
-			( (YY) >= enclosementall.y0) &&\
-			( (YY) <= enclosementall.y1)\
-		) {\
-			if ( (ispotwY[ (YY)-enclosementall.y0 ]) &&\
-				( (MM) >= mem0) &&\
-				( (MM) <= mem1) \
-			) {\
-				ERG32=ispotwY[ (YY)-enclosementall.y0][ (MM)-mem0 ];\
-			}\
-		}\
+	int8_t overlap=cyclesoverlap();
+	for(int32_t cp=0;cp<nbr_of_cp;cp++) {
+		if (cycleselected(cp) <= 0) continue;
+		batchrecord(buf,alinenr,apt,cp,overlap);
 	}
-
-	// YY is ABSOLUTE screen coordinates
-	// MM is ABSOLUTE mem position, i.e. *32 is pixel coordinate
-	#define CELLCOLOR_XY(XX,YY,ERG) \
-	{\
-		ERG=SQUARE_POTW;\
-		if (\
-			( (XX) >= enclosementall.x0) &&\
-			( (XX) <= enclosementall.x1) &&\
-			( (YY) >= enclosementall.y0) &&\
-			( (YY) <= enclosementall.y1) \
-		) {\
-			int bmem=(XX) >> SHIFTPERDDBYTE;\
-			DDBYTE f32;\
-			GET32_MY(bmem,YY,f32);\
-			int bbit=(XX) % (1 << SHIFTPERDDBYTE);\
-			ERG=(f32 >> bbit) & 0b1;\
-		}\
+	metricsrecord(alinenr,apt,t1-t0,t2-t1,wallseconds()-t0);
+	if (anzanalyzed <= 0) {
+		batchrecord(buf,alinenr,apt,-1,0);
+		anzanalyzed=1;
 	}
 	
-	int32_t interiorpresentat=0;
-	onecycle.interiorfound=0;
-	int8_t* ywithgray=NULL;
-	for(int32_t REFINEMENT=LEVEL0;REFINEMENT<=LEVEL1;REFINEMENT++) {
-		printf("\nchecking level %i ",REFINEMENT);
-		int32_t SCREENWIDTH=(1 << REFINEMENT);
-		int32_t MAXMEM=SCREENWIDTH >> SHIFTPERDDBYTE;
-		scaleRangePerPixel=(COMPLETE1-COMPLETE0)/(double)SCREENWIDTH;
-		scalePixelPerRange=(double)SCREENWIDTH/(COMPLETE1-COMPLETE0);
-		enclosementall.x0=enclosementall.y0=SCREENWIDTH;
-		enclosementall.x1=enclosementall.y1=0;
-		for(int32_t k=0;k<onecycle.cyclelen;k++) {
-			int32_t xx=scrcoord_as_lowerleft(onecycle.cycle[k].pp.re);
-			int32_t yy=scrcoord_as_lowerleft(onecycle.cycle[k].pp.im);
-			ScreenRect scr;
-			scr.x0=xx-_ENCLOSEMENTWIDTH; 
-			scr.x1=xx+_ENCLOSEMENTWIDTH;
-			scr.y0=yy-_ENCLOSEMENTWIDTH;
-			scr.y1=yy+_ENCLOSEMENTWIDTH;
-
-			#define TRIM(WW) \
-			{\
-				if ( WW < 0) WW=0;\
-				else if (WW >= SCREENWIDTH) WW=SCREENWIDTH-1;\
-			}
+	return anzanalyzed;
+}
 
-			TRIM(scr.x0)
-			TRIM(scr.x1)
-			TRIM(scr.y0)
-			TRIM(scr.y1)
-			
-			if (scr.x0 < enclosementall.x0) enclosementall.x0=scr.x0;
-			if (scr.x1 > enclosementall.x1) enclosementall.x1=scr.x1;
-			if (scr.y0 < enclosementall.y0) enclosementall.y0=scr.y0;
-			if (scr.y1 > enclosementall.y1) enclosementall.y1=scr.y1;
-			
-			onecycle.cycle[k].mem0=scr.x0 >> SHIFTPERDDBYTE;
-			onecycle.cycle[k].mem1=scr.x1 >> SHIFTPERDDBYTE;
-			if (onecycle.cycle[k].mem1 >= MAXMEM) {
-				LOGMSG("Implementation error. Maxmem reached\n");
-				exit(99);
-			}
-			onecycle.cycle[k].y0=scr.y0;
-			onecycle.cycle[k].y1=scr.y1;
+// CONTINUE: critical points, cycles and levels of the parameter set
+// just analyzed, the next SWEEP point starts from them
+void continuationsave(void) {
+	anzcont=nbr_of_cp;
+	for(int32_t cp=0;cp<nbr_of_cp;cp++) {
+		ContinuationCycle& c=contcycle[cp];
+		c.attractor=zero[cp].attractor;
+		c.period=0;
+		c.level=0;
+		if (zero[cp].cyclelen > 0) {
+			c.pp=zero[cp].cycle[0].pp;
+			c.period=zero[cp].cyclelen;
+			c.level=zero[cp].interiorfound;
 		}
+	}
+}
+
+// task for BATCH/SWEEP: progress output is not wanted with the
+// results, the bitmap stays allocated for the next parameter set
+void batchtask(CmTask& task) {
+	task.out=new TextBuffer;
+	task.rows=new ArrayDDByteManager;
+	task.tiles=new TiledBitmap;
+}
+
+void batchtaskfree(CmTask& task) {
+	delete task.out;
+	delete task.rows;
+	delete task.tiles;
+	task.out=NULL;
+	task.rows=NULL;
+	task.tiles=NULL;
+}
+
+FILE* batchresultfile(void) {
+	if (!_BATCHOUT[0]) return stdout;
+	
+	FILE* f=fopen(_BATCHOUT,"wt");
+	if (!f) {
+		LOGMSG2("Error. Result file %s not writeable.\n",_BATCHOUT);
+		fail();
+	}
+	
+	return f;
+}
+
+// BATCH=file: every line of the file holds parameters as on the
+// command line (on top of those given there), all cycles of a line
+// are analyzed in-process and written as one record each. Orbit
+// and bitmap memory is reused from line to line
+void runbatch(int32_t argc,char** argv) {
+	FILE* fin=fopen(_BATCHFILE,"rt");
+	if (!fin) {
+		LOGMSG2("Error. Batch file %s not readable.\n",_BATCHFILE);
+		fail();
+	}
+	FILE* fres=batchresultfile();
+	fprintf(flog,"batch %s\n",_BATCHFILE);
+	batchheader(fres,0);
+	
+	CmTask task;
+	batchtask(task);
+	TextBuffer buf;
+	
+	char line[4096];
+	int32_t linenr=0,anzlines=0,anzrecords=0;
+	while (fgets(line,sizeof(line),fin)) {
+		linenr++;
+		char* tok=strtok(line," \t\r\n");
+		if ( (!tok) || (tok[0] == '#') ) continue;
 		
-		int32_t mem0=enclosementall.x0 >> SHIFTPERDDBYTE;
-		int32_t mem1=enclosementall.x1 >> SHIFTPERDDBYTE;
-		if (mem1 >= MAXMEM) {
-			LOGMSG("Implementation error. Maxmem/2 reached\n");
-			exit(99);
+		setdefaults();
+		for(int32_t i=1;i<argc;i++) parseparam(argv[i]);
+		while (tok) {
+			parseparam(tok);
+			tok=strtok(NULL," \t\r\n");
 		}
+		setupparams();
+		// bitmaps are not exported
+		_EXPORTFILE[0]=0;
+		anzlines++;
 		
-		// translate enclosementall into complex coordinates
-		local.x0=onecycle.ps_basinrect.x0=enclosementall.x0*scaleRangePerPixel + COMPLETE0;
-		local.x1=onecycle.ps_basinrect.x1=(enclosementall.x1+1)*scaleRangePerPixel + COMPLETE0;
-		local.y0=onecycle.ps_basinrect.y0=enclosementall.y0*scaleRangePerPixel + COMPLETE0;
-		local.y1=onecycle.ps_basinrect.y1=(enclosementall.y1+1)*scaleRangePerPixel + COMPLETE0;
-		
-		if (REFINEMENT==LEVEL0) printf("allocating ");
-		
-		int32_t LOCALLENY=enclosementall.y1-enclosementall.y0 + 1;
-		int32_t LOCALLENX=mem1-mem0+1;
+		task.threads=THREADS;
+		buf.clear();
+		anzrecords += batchanalyze(task,buf,linenr,NULL);
+		if (buf.text) fputs(buf.text,fres);
+		fflush(fres);
+	} // line
+	
+	fclose(fin);
+	if (fres != stdout) fclose(fres);
+	batchtaskfree(task);
+	fprintf(flog,"batch: %i parameter lines, %i records\n",anzlines,anzrecords);
+}
 
-		if (ywithgray) delete[] ywithgray;
-		ywithgray=new int8_t[LOCALLENY];
-		for(int32_t y=0;y<LOCALLENY;y++) {
-			ywithgray[y]=0;
-		}
+// value i of n equidistant values from a0 to a1 (both included)
+double gridvalue(const double a0,const double a1,const int32_t n,const int32_t i) {
+	if (n <= 1) return a0;
+	
+	return a0 + (a1-a0)*i/(n-1);
+}
 
-		// now go over the enclosements again and
-		// set rows intersecting an enclosement to 1
-		// so memory gets allocated and the row checked
-		for(int32_t k=0;k<onecycle.cyclelen;k++) {
-			for(int32_t y=onecycle.cycle[k].y0;y<=onecycle.cycle[k].y1;y++) {
-				ywithgray[y-enclosementall.y0]=1;
-			}
-		}
+inline int8_t writeall(const int afd,const char* p,int64_t alen) {
+	#ifdef _FORKAVAILABLE
+	while (alen > 0) {
+		ssize_t w=write(afd,p,(size_t)alen);
+		if (w <= 0) return 0;
+		p += w;
+		alen -= w;
+	}
+	return 1;
+	#else
+	return 0;
+	#endif
+}
 
-		// allocate enough memory
-		mgr.FreeAll();
-		// now pointers in zeilenY are invalid
-		// now delete that array
-		if (ispotwY) delete[] ispotwY;
-		ispotwY=new PDDBYTE[LOCALLENY];
-		if (!ispotwY) {
-			LOGMSG("Memory error. ispotwY\n");
-			exit(99);
+// SWEEP/SWEEPA: every point of the c grid, the A grid and the
+// BATCH lines (if given, else the command line) is a parameter set.
+// With SHARD=i/n only the points with index = i mod n are computed,
+// the records are written in increasing point index, so shards
+// merge by sorting on that column.
+// THREADS=n: n worker processes (the state of an analysis is global)
+// take the next point from a shared counter, points without an
+// attracting cycle cost a fraction of those with one. Every worker
+// writes its records into its own temporary file, the main process
+// copies them in point order as they are finished
+void runsweep(int32_t argc,char** argv) {
+	SweepGrid gc=_SWEEPC;
+	SweepGrid ga=_SWEEPA;
+	const int8_t cgrid=( (gc.nre > 0) && (gc.nim > 0) );
+	const int8_t agrid=( (ga.nre > 0) && (ga.nim > 0) );
+	if (gc.nre < 1) gc.nre=1;
+	if (gc.nim < 1) gc.nim=1;
+	if (ga.nre < 1) ga.nre=1;
+	if (ga.nim < 1) ga.nim=1;
+	int32_t shard=_SHARD,shards=_SHARDS;
+	if (shards < 1) shards=1;
+	if ( (shard < 0) || (shard >= shards) ) {
+		LOGMSG3("Error. SHARD=%i/%i invalid.\n",shard,shards);
+		fail();
+	}
+	
+	// BATCH lines used as parameter sets at every grid point
+	int32_t anzlines=0;
+	char** lines=NULL;
+	int32_t* linenrs=NULL;
+	if (_BATCHFILE[0]) {
+		FILE* fin=fopen(_BATCHFILE,"rt");
+		if (!fin) {
+			LOGMSG2("Error. Batch file %s not readable.\n",_BATCHFILE);
+			fail();
 		}
-
-		for(int32_t y=0;y<LOCALLENY;y++) {
-			if (ywithgray[y]>0) {
-				ispotwY[y]=mgr.getMemory(LOCALLENX);
-				if (!ispotwY[y]) {
-					LOGMSG("Memory error. ispotwY/2\n");
-					exit(99);
+		char line[4096];
+		int32_t linenr=0,allocated=0;
+		while (fgets(line,sizeof(line),fin)) {
+			linenr++;
+			char* p=line;
+			while ( (*p == ' ') || (*p == '\t') ) p++;
+			if ( (*p == 0) || (*p == '\r') || (*p == '\n') || (*p == '#') ) continue;
+			if (anzlines >= allocated) {
+				allocated=2*allocated+16;
+				char** l2=new char*[allocated];
+				int32_t* n2=new int32_t[allocated];
+				for(int32_t i=0;i<anzlines;i++) {
+					l2[i]=lines[i];
+					n2[i]=linenrs[i];
 				}
-				// set ALL to startvalue
-				for(int32_t m=0;m<LOCALLENX;m++) {
-					ispotwY[y][m]=startwith;
-				}
-			} else {
-				ispotwY[y]=NULL;
+				if (lines) delete[] lines;
+				if (linenrs) delete[] linenrs;
+				lines=l2;
+				linenrs=n2;
 			}
+			lines[anzlines]=new char[strlen(p)+1];
+			strcpy(lines[anzlines],p);
+			linenrs[anzlines]=linenr;
+			anzlines++;
+		}
+		fclose(fin);
+		if (anzlines <= 0) {
+			LOGMSG("Error. No parameters in batch file.\n");
+			fail();
 		}
+	}
+	
+	int64_t perline=(int64_t)gc.nre*gc.nim*ga.nre*ga.nim;
+	int64_t total=perline*(anzlines > 0 ? anzlines : 1);
+	int64_t anzlocal=(total-shard+shards-1) / shards;
+	if (anzlocal < 0) anzlocal=0;
+	int32_t workers=THREADS;
+	if (workers > anzlocal) workers=(int32_t)anzlocal;
+	if (workers < 1) workers=1;
+	#ifndef _FORKAVAILABLE
+	workers=1;
+	#endif
+	
+	FILE* fres=batchresultfile();
+	fprintf(flog,"sweep: %lld points, shard %i/%i: %lld points, %i workers\n",
+		(long long)total,shard,shards,(long long)anzlocal,workers);
+	if (_CONTINUE >= 0) fprintf(flog,"sweep: continued from point to point, level margin %i\n",_CONTINUE);
+	batchheader(fres,1);
+	fflush(fres);
+	fflush(flog);
+	fflush(stdout);
+	
+	// point k of this shard: parameters set up, records into buf
+	CmTask task;
+	TextBuffer buf;
+	// CONTINUE: BATCH line of the previous point of the process
+	int32_t contline=-1;
+	auto sweeppoint=[&](const int64_t k) {
+		SweepPoint pt;
+		pt.idx=shard+k*shards;
+		int64_t r=pt.idx % perline;
+		int32_t li=(int32_t)(pt.idx / perline);
+		int64_t nc=(int64_t)gc.nre*gc.nim;
+		int64_t ic=r % nc;
+		pt.ia=(int32_t)(r / nc);
+		pt.ix=(int32_t)(ic % gc.nre);
+		pt.iy=(int32_t)(ic / gc.nre);
 		
-		// setting all enclosements of periodic points
-		// to GRAY
-		for(int32_t k=0;k<onecycle.cyclelen;k++) {
-			for(int32_t y=onecycle.cycle[k].y0;y<=onecycle.cycle[k].y1;y++) {
-				for(int32_t m=onecycle.cycle[k].mem0;m<=onecycle.cycle[k].mem1;m++) {
-					SET32_MY(m,y,ALL32GRAY);
-				}
+		setdefaults();
+		for(int32_t i=1;i<argc;i++) parseparam(argv[i]);
+		if (anzlines > 0) {
+			char line[4096];
+			strncpy(line,lines[li],sizeof(line)-1);
+			line[sizeof(line)-1]=0;
+			char* tok=strtok(line," \t\r\n");
+			while (tok) {
+				parseparam(tok);
+				tok=strtok(NULL," \t\r\n");
 			}
 		}
+		// the grid values are read in as command-line values are
+		char tmp[256];
+		if (cgrid > 0) {
+			sprintf(tmp,"C=%.17lg,%.17lg",
+				gridvalue(gc.re0,gc.re1,gc.nre,pt.ix),
+				gridvalue(gc.im0,gc.im1,gc.nim,pt.iy));
+			parseparam(tmp);
+		}
+		if (agrid > 0) {
+			sprintf(tmp,"A=%.17lg,%.17lg",
+				gridvalue(ga.re0,ga.re1,ga.nre,pt.ia % ga.nre),
+				gridvalue(ga.im0,ga.im1,ga.nim,pt.ia / ga.nre));
+			parseparam(tmp);
+		}
+		setupparams();
+		// points are not resumed, CACHE keeps their levels,
+		// bitmaps are not exported
+		_CHECKPOINTFILE[0]=_RESUMEFILE[0]=0;
+		_EXPORTFILE[0]=0;
 		
-		// going over the interesting (GRAY) regions
-		// and try to propagate POTENTIALLY_WHITE until
-		// no change occurs
-		// anything still GRAY is then bounded
-		// and means, BLACK will emerge at level REFINEMENT
-		// in the fullTSA
-		
-		if (REFINEMENT==LEVEL0) printf(" analyzing ");
-		else printf(" ");
+		// parallel over points, not over rows
+		task.threads=(workers > 1 ? 1 : THREADS);
+		buf.clear();
+		// CONTINUE: only from a point of the same BATCH line
+		if (li != contline) anzcont=0;
+		contline=li;
+		int32_t anz=batchanalyze(task,buf,(anzlines > 0 ? linenrs[li] : 0),&pt);
+		if (_CONTINUE >= 0) continuationsave();
+		return anz;
+	};
+	
+	int64_t anzrecords=0;
+	if (workers <= 1) {
+		batchtask(task);
+		for(int64_t k=0;k<anzlocal;k++) {
+			anzrecords += sweeppoint(k);
+			if (buf.text) fputs(buf.text,fres);
+			fflush(fres);
+		}
+		batchtaskfree(task);
+	} else {
+		#ifdef _FORKAVAILABLE
+		// shared: next point to take, per point done flag and worker
+		int64_t sharedbytes=sizeof(int64_t) + anzlocal*(sizeof(int8_t)+sizeof(int16_t));
+		void* shm=mmap(NULL,(size_t)sharedbytes,PROT_READ | PROT_WRITE,MAP_SHARED | MAP_ANONYMOUS,-1,0);
+		if (shm == MAP_FAILED) {
+			LOGMSG("Error. Sweep shared memory.\n");
+			fail();
+		}
+		int64_t* nextpoint=(int64_t*)shm;
+		int8_t* pointdone=(int8_t*)&nextpoint[1];
+		int16_t* pointworker=(int16_t*)&pointdone[anzlocal];
+		*nextpoint=0;
+		for(int64_t k=0;k<anzlocal;k++) {
+			pointdone[k]=0;
+			pointworker[k]=-1;
+		}
 		
-		int8_t changed=1;
-		PlaneRect A,bbxfA;
-		int32_t noch0=256*(24-REFINEMENT);
-		if (noch0<1) noch0=1;
-		int32_t noch=1;
+		if (workers > INT16_MAX) workers=INT16_MAX;
+		FILE** wfile=new FILE*[workers];
+		pid_t* wpid=new pid_t[workers];
+		int64_t* wread=new int64_t[workers];
+		for(int32_t w=0;w<workers;w++) {
+			wfile[w]=tmpfile();
+			if (!wfile[w]) {
+				LOGMSG("Error. Sweep temporary file.\n");
+				fail();
+			}
+			wread[w]=0;
+		}
 		
-		while (changed>0) {
-			changed=0;
-			if ((--noch)<=0) {
-				printf(".");
-				noch=noch0;
+		for(int32_t w=0;w<workers;w++) {
+			wpid[w]=fork();
+			if (wpid[w] < 0) {
+				LOGMSG("Error. Sweep worker not started.\n");
+				fail();
 			}
-			
-			// go over enclosementall, so points in overlapping
-			// enclosement[k]'s will not be analyzed twice
-			// in that round of the while-loop
-			for(int32_t y=enclosementall.y0;y<=enclosementall.y1;y++) {
-				if (ywithgray[y-enclosementall.y0]<=0) continue;
-				
-				int8_t graythere=0;
-				
-				A.y0=y*scaleRangePerPixel + COMPLETE0;
-				A.y1=A.y0+scaleRangePerPixel;
-				for(int32_t m=mem0;m<=mem1;m++) {
-					DDBYTE ff;
-					GET32_MY(m,y,ff);
-					if (ff == ALL32POTW) continue;
-					BYTE fchanged=0;
-					DDBYTE fneu=ff;
-					
-					uint32_t xcoord0=m << SHIFTPERDDBYTE;
-					
-					for(int32_t bit=0;bit<32;bit++) {
-						BYTE tmpf=ff & 0b1;
-						ff >>= 1;
-						if (tmpf == SQUARE_POTW) continue;
-						
-						graythere=1;
-						
-						int xc=xcoord0+bit;
-						A.x0=xc*scaleRangePerPixel + COMPLETE0;
-						A.x1=A.x0+scaleRangePerPixel;
-						
-						getBoundingBoxfA(A,bbxfA);
-						
-						// bbxfA overlaps with outside of cycle enclosement (local)
-						if (
-							(SQUARE_LIES_ENTIRELY_IN_LOCAL(bbxfA) <= 0) ||
-							(SQUARE_LIES_ENTIRELY_IN_COMPLETE(bbxfA) <= 0)
-						) {
-							fchanged=1;
-							fneu |= (1 << bit);
-							continue;
-						}
-						
-						ScreenRect scr;
-						scr.x0=scrcoord_as_lowerleft(bbxfA.x0);
-						scr.x1=scrcoord_as_lowerleft(bbxfA.x1);
-						scr.y0=scrcoord_as_lowerleft(bbxfA.y0);
-						scr.y1=scrcoord_as_lowerleft(bbxfA.y1);
-						// scr is in "screen", i.e. >= 0 and < SCREENWIDTH in all coordinates
-						
-						// check the intersected with pixels
-						int8_t hitspotentiallywhite=0;
-						for(int32_t by=scr.y0;by<=scr.y1;by++) {
-							for(int32_t bx=scr.x0;bx<=scr.x1;bx++) {
-								BYTE bf;
-								CELLCOLOR_XY(bx,by,bf);
-								if (bf == SQUARE_POTW) {
-									hitspotentiallywhite=1;
-									break;
-								}
-							}
-							if (hitspotentiallywhite>0) break;
-						}
-						
-						if (hitspotentiallywhite>0) {
-							fchanged=1;
-							fneu |= (1 << bit);
-						}
-						
-					} // bit
-					
-					if (fchanged>0) {
-						changed=1;
-						SET32_MY(m,y,fneu);
+			if (wpid[w] == 0) {
+				// worker: records with their length in front
+				int fd=fileno(wfile[w]);
+				batchtask(task);
+				while (1) {
+					int64_t k=__atomic_fetch_add(nextpoint,1,__ATOMIC_RELAXED);
+					if (k >= anzlocal) break;
+					sweeppoint(k);
+					int32_t len=buf.len;
+					if ( 
+						(writeall(fd,(const char*)&len,sizeof(len)) <= 0) ||
+						(writeall(fd,buf.text,len) <= 0)
+					) {
+						_exit(99);
 					}
-				} // m
-				
-				if (graythere<=0) {
-					ywithgray[y-enclosementall.y0]=0;
+					pointworker[k]=(int16_t)w;
+					__atomic_store_n(&pointdone[k],1,__ATOMIC_RELEASE);
 				}
-			} // y
-		} // main-while loop as long as new information
-		// is being created
+				// inherited stdio buffers are not flushed twice
+				_exit(0);
+			}
+		}
 		
-		// if GRAY cells are present = black emerges
-		interiorpresentat=0;
-		// ywithgray: not indicative any more of pointer present
-		for(int32_t y=0;y<LOCALLENY;y++) {
-			if (!ispotwY[y]) continue;
+		int32_t running=workers;
+		char* rec=NULL;
+		int32_t recallocated=0;
+		for(int64_t k=0;k<anzlocal;) {
+			if (__atomic_load_n(&pointdone[k],__ATOMIC_ACQUIRE) == 0) {
+				int status;
+				pid_t pid=waitpid(-1,&status,WNOHANG);
+				if (pid > 0) {
+					running--;
+					if ( (!WIFEXITED(status)) || (WEXITSTATUS(status) != 0) ) {
+						LOGMSG("Error. Sweep worker terminated.\n");
+						fail();
+					}
+				} else if (running <= 0) {
+					LOGMSG("Error. Sweep point not computed.\n");
+					fail();
+				} else {
+					usleep(1000);
+				}
+				continue;
+			}
 			
-			for(int32_t m=0;m<LOCALLENX;m++) {
-				// is cell still GRAY
-				if (ispotwY[y][m] != ALL32POTW) {
-					interiorpresentat=REFINEMENT;
-					break;
-				} // m
-				if (interiorpresentat>0) break;
+			int32_t w=pointworker[k];
+			int fd=fileno(wfile[w]);
+			int32_t len=0;
+			if (pread(fd,&len,sizeof(len),wread[w]) != (ssize_t)sizeof(len)) {
+				LOGMSG("Error. Sweep result not readable.\n");
+				fail();
 			}
-			if (interiorpresentat>0) break;
-		} // k
-
-		if (interiorpresentat>0) break;
-	} // REFINEMENT
+			wread[w] += sizeof(len);
+			if (len >= recallocated) {
+				if (rec) delete[] rec;
+				recallocated=2*len+1024;
+				rec=new char[recallocated];
+			}
+			if (pread(fd,rec,len,wread[w]) != (ssize_t)len) {
+				LOGMSG("Error. Sweep result not readable/2.\n");
+				fail();
+			}
+			wread[w] += len;
+			rec[len]=0;
+			fputs(rec,fres);
+			for(int32_t i=0;i<len;i++) {
+				if (rec[i] == '\n') anzrecords++;
+			}
+			k++;
+			if ( (k >= anzlocal) || (__atomic_load_n(&pointdone[k],__ATOMIC_ACQUIRE) == 0) ) fflush(fres);
+		}
+		
+		while (running > 0) {
+			int status;
+			if (waitpid(-1,&status,0) <= 0) break;
+			running--;
+		}
+		if (rec) delete[] rec;
+		for(int32_t w=0;w<workers;w++) fclose(wfile[w]);
+		delete[] wfile;
+		delete[] wpid;
+		delete[] wread;
+		munmap(shm,(size_t)sharedbytes);
+		#endif
+	}
 	
-	onecycle.interiorfound=interiorpresentat;
-	delete[] ywithgray;
-	mgr.FreeAll();
-
-	return interiorpresentat;
+	if (fres != stdout) fclose(fres);
+	for(int32_t i=0;i<anzlines;i++) delete[] lines[i];
+	if (lines) delete[] lines;
+	if (linenrs) delete[] linenrs;
+	fprintf(flog,"sweep: %lld records\n",(long long)anzrecords);
 }
 
-// struct Root
+// BENCH: corpus of every built-in function, positive and negative
+// ENCW and levels up to 14, with the levels black emerges at per
+// analyzed cycle (0 = none, -1 ends the list). A faster hot path
+// must not change them. Large sets (levels up to 20, one per
+// bounding-box kernel) only from BENCH=2 on, run once
+struct BenchEntry {
+	const char* params;
+	int32_t golden[4];
+	int8_t large=0;
+};
 
-void Root::clear(void) {
-	cyclelen=0;
-	cycle=NULL;
-	interiorfound=0;
-	multiplier=0.0;
-}
+const BenchEntry benchcorpus[] = {
+	{"func=z2c c=-1,0 level=8,12",{8,-1}},
+	{"func=z2c c=-1,0 encw=-64 level=8,12",{8,-1}},
+	{"func=z2c c=-0.123,0.745 level=8,12",{9,-1}},
+	{"func=z2c c=-1.3,0.05 level=10,14",{14,-1}},
+	{"func=z2c c=-0.74,0.1 level=8,12",{0,-1}},
+	{"func=z2azc c=-0.5,0.2 a=0.3,0.1 level=8,12",{8,-1}},
+	{"func=z3azc c=0.4139,0.4761 a=0.5,0 encw=64 level=9,13",{11,-1}},
+	{"func=z3azc c=0.3,0.1 a=0.2,0.3 encw=-32 level=8,12",{8,-1}},
+	{"func=z4azc c=0,-0.171875 a=1.375,0 encw=256 level=10,12",{12,0,0,-1}},
+	{"func=z5azc c=-0.6178,-0.3424 a=0.1,0 encw=64 level=9,13",{11,-1}},
+	{"func=z6azc c=0.3817,0.5122 a=0.2,0 encw=-64 level=9,13",{12,-1}},
+	{"func=z7azc c=-0.5304,0.4354 a=0.2,0 encw=64 level=9,13",{13,-1}},
+	{"func=z2c c=-0.747,0 level=17,20",{19,-1},1},
+	{"func=z2azc c=-0.835,0 a=0.2,0 level=17,20",{19,-1},1},
+	{"func=z3azc c=0.9595,0 a=-1.5,0 level=17,19",{18,-1},1}
+};
 
-int32_t main(int32_t argc,char** argv) {
-	int32_t c0=clock();
+// BENCH: the stateful modes, each compared with the golden levels
+// of a plain run. Returns the number of checks that fail
+int32_t runbenchstate(int32_t argc,char** argv,CmTask& task) {
+	const BenchEntry ckcache={"func=z2c c=-1.3,0.05 level=10,14",{14,-1}};
+	const BenchEntry ckresume={"func=z3azc c=0.4139,0.4761 a=0.5,0 encw=64 level=9,13",{11,-1}};
+	const BenchEntry ckexport={"func=z2c c=-0.123,0.745 level=8,12",{9,-1}};
+	const BenchEntry cklibrary={"func=z4azc c=0,-0.171875 a=1.375,0 encw=256 level=10,12",{12,0,0,-1}};
+	// CONTINUE: a line of points towards c=-0.75, golden levels
+	// from a plain run
+	const int32_t ANZCONTINUE=6;
+	BenchEntry ckcontinue[ANZCONTINUE]={
+		{"func=z2c c=-0.72,0 level=10,18",{-1}},
+		{"func=z2c c=-0.725,0 level=10,18",{-1}},
+		{"func=z2c c=-0.73,0 level=10,18",{-1}},
+		{"func=z2c c=-0.735,0 level=10,18",{-1}},
+		{"func=z2c c=-0.74,0 level=10,18",{-1}},
+		{"func=z2c c=-0.745,0 level=10,18",{-1}}
+	};
+	const char* fn="tsabench.tmp";
+	TextBuffer buf;
+	int32_t failed=0;
 	
-	flog=fopen("tsapredictor.log","at");
-	fprintf(flog,"\n-----------------\n");
+	auto setentry=[&](const BenchEntry& ae) {
+		setdefaults();
+		for(int32_t i=1;i<argc;i++) parseparam(argv[i]);
+		char line[1024];
+		strncpy(line,ae.params,sizeof(line)-1);
+		line[sizeof(line)-1]=0;
+		char* tok=strtok(line," ");
+		while (tok) {
+			parseparam(tok);
+			tok=strtok(NULL," ");
+		}
+		setupparams();
+		task.threads=THREADS;
+	};
+	// levels of the selected cycles are the golden ones
+	auto golden=[&](const BenchEntry& ae) {
+		int32_t k=0;
+		for(int32_t cp=0;cp<nbr_of_cp;cp++) {
+			if (cycleselected(cp) <= 0) continue;
+			if ( (k >= 3) || (ae.golden[k] != zero[cp].interiorfound) ) return 0;
+			k++;
+		}
+		return (int)( (k <= 3) && (ae.golden[k] < 0) );
+	};
+	// every level of the selected cycles came from asource
+	auto allfrom=[&](const int32_t asource) {
+		int32_t n=0;
+		for(int32_t cp=0;cp<nbr_of_cp;cp++) {
+			if (cycleselected(cp) <= 0) continue;
+			for(int32_t i=0;i<zero[cp].anzmetrics;i++) {
+				if (zero[cp].metrics[i].source != asource) return 0;
+				n++;
+			}
+		}
+		return (int)(n > 0);
+	};
+	auto anyfrom=[&](const int32_t asource) {
+		for(int32_t cp=0;cp<nbr_of_cp;cp++) {
+			if (cycleselected(cp) <= 0) continue;
+			for(int32_t i=0;i<zero[cp].anzmetrics;i++) {
+				if (zero[cp].metrics[i].source == asource) return 1;
+			}
+		}
+		return 0;
+	};
+	auto firstcycle=[&](void) {
+		for(int32_t cp=0;cp<nbr_of_cp;cp++) {
+			if (cycleselected(cp) > 0) return cp;
+		}
+		return -1;
+	};
+	auto result=[&](const char* aname,const int8_t aok,const char* anote) {
+		LOGMSG4("  %-10s %-7s %s\n",aname,(aok > 0 ? "ok" : "DIFFERS"),anote);
+		if (aok <= 0) failed++;
+	};
+	char tmp[1100];
 	
-	printf("  FUNC=string / c=re,im / A=re,im / ENCW=n / LEVEL=n,m / PERIODS=n,m\n");
+	LOGMSG("\nstateful modes:\n");
 	
-	// standard
-	getBoundingBoxfA=getBoundingBoxfA_z2c;
-	_FUNC=FUNC_Z2C;
-	COMPLETE0=-2;
-	COMPLETE1=2;
-	seedC0re=seedC1re=floor(-1.0*DENOM225) / DENOM225; 
-	seedC0im=seedC1im=floor(0.0*DENOM225) / DENOM225; 
-	FAKTORAre=FAKTORAim=0.0;
-	_ENCLOSEMENTWIDTH=128;
-	LEVEL0=10;
-	LEVEL1=24;
-	_STARTWITH=ALL32POTW;
-		
-	for(int32_t i=1;i<argc;i++) {
-		upper(argv[i]);
-		if (strstr(argv[i],"FUNC=")==argv[i]) {
-			_FUNC=getfuncidx(&argv[i][5]);
-		} else if (strstr(argv[i],"C=")==argv[i]) {
-			double r0,i0; // not NTYP
-			// command line parameters are always considered double no matter the datatype used
-			if (sscanf(&argv[i][2],"%lf,%lf",&r0,&i0) == 2) {
-				seedC0re=seedC1re=floor(r0*DENOM225)/DENOM225;
-				seedC0im=seedC1im=floor(i0*DENOM225)/DENOM225;
-			}
-		} else if (strstr(argv[i],"A=")==argv[i]) {
-			double r0,i0;
-			if (sscanf(&argv[i][2],"%lf,%lf",&r0,&i0) == 2) {
-				FAKTORAre=floor(r0*DENOM225)/DENOM225;
-				FAKTORAim=floor(i0*DENOM225)/DENOM225;
-			}
-		} else if (strstr(argv[i],"ENCW=")==argv[i]) {
-			int32_t a;
-			if (sscanf(&argv[i][5],"%i",&a) == 1) {
-				if (a < 0) {
-					a=-a;
-					_STARTWITH=ALL32GRAY; // all gray, i.e. to analyze
-				} else {
-					_STARTWITH=ALL32POTW; 
+	// CACHE: a second run takes every level from the cache
+	if (rcache.f) {
+		LOGMSG("  CACHE      skipped (CACHE given)\n");
+	} else {
+		sprintf(tmp,"%s.cache",fn);
+		remove(tmp);
+		setentry(ckcache);
+		rcache.open(tmp);
+		batchanalyze(task,buf,0,NULL);
+		int8_t ok=golden(ckcache) && allfrom(LEVELSOURCE_COMPUTED);
+		batchanalyze(task,buf,0,NULL);
+		ok=ok && golden(ckcache) && allfrom(LEVELSOURCE_CACHE);
+		rcache.close();
+		remove(tmp);
+		result("CACHE",ok,"second run all levels cached");
+	}
+	
+	// CHECKPOINT/RESUME: a forked run is preempted after some
+	// checkpoints, the levels resumed from them are the golden ones.
+	// Only the plain sweep writes checkpoints, whatever PROPAGATION
+	// the other sets run with
+	#ifdef _FORKAVAILABLE
+	{
+		auto setresume=[&](void) {
+			setentry(ckresume);
+			_PROPAGATION=PROPAGATION_SWEEP;
+		};
+		setresume();
+		batchanalyze(task,buf,0,NULL);
+		int8_t ok=golden(ckresume);
+		int32_t cp=firstcycle();
+		char ckfn[1200];
+		sprintf(ckfn,"%s.c%i",fn,(cp >= 0 ? zero[cp].cyclenumber : 0));
+		remove(ckfn);
+		fflush(NULL);
+		pid_t pid=fork();
+		if (pid == 0) {
+			setresume();
+			strcpy(_CHECKPOINTFILE,fn);
+			_CHECKPOINTSECONDS=0;
+			benchckptwritten=0;
+			benchpreempt=12;
+			batchanalyze(task,buf,0,NULL);
+			// finished before: no checkpoint left
+			_exit(1);
+		}
+		int status=-1;
+		if (pid > 0) waitpid(pid,&status,0);
+		CheckpointHeader h;
+		ok=ok && (pid > 0) && WIFEXITED(status) && (WEXITSTATUS(status) == 0);
+		ok=ok && (readcheckpointheader(ckfn,h) > 0) && (h.level > 0);
+		char note[128];
+		sprintf(note,"preempted in level %i",(ok > 0 ? h.level : 0));
+		setresume();
+		strcpy(_CHECKPOINTFILE,fn);
+		strcpy(_RESUMEFILE,fn);
+		batchanalyze(task,buf,0,NULL);
+		ok=ok && golden(ckresume) && anyfrom(LEVELSOURCE_CHECKPOINT);
+		_CHECKPOINTFILE[0]=_RESUMEFILE[0]=0;
+		_CHECKPOINTSECONDS=600;
+		remove(ckfn);
+		result("RESUME",ok,note);
+	}
+	#endif
+	
+	// EXPORT: the file holds the level found and consistent rows
+	{
+		setentry(ckexport);
+		strcpy(_EXPORTFILE,fn);
+		batchanalyze(task,buf,0,NULL);
+		_EXPORTFILE[0]=0;
+		int8_t ok=golden(ckexport);
+		int32_t cp=firstcycle();
+		sprintf(tmp,"%s.c%i",fn,(cp >= 0 ? zero[cp].cyclenumber : 0));
+		FILE* f=fopen(tmp,"rb");
+		ExportHeader eh;
+		int64_t gray=0;
+		if ( (!f) || (fread(&eh,sizeof(eh),1,f) != 1) ) {
+			ok=0;
+		} else {
+			ok=ok && (memcmp(eh.magic,EXPORTMAGIC,sizeof(eh.magic)) == 0) && (eh.level == zero[cp].interiorfound);
+			int32_t width=eh.pixels.x1-eh.pixels.x0+1;
+			for(int32_t y=eh.pixels.y0;(y<=eh.pixels.y1) && (ok>0);y++) {
+				int32_t anzruns=0,sum=0;
+				if ( (fread(&anzruns,sizeof(anzruns),1,f) != 1) || (anzruns < 1) || (anzruns > width+1) ) {
+					ok=0;
+					break;
 				}
-				_ENCLOSEMENTWIDTH=a;
+				for(int32_t r=0;r<anzruns;r++) {
+					int32_t len;
+					if ( (fread(&len,sizeof(len),1,f) != 1) || (len < 0) || ( (r > 0) && (len <= 0) ) ) ok=0;
+					sum += len;
+					if (r & 1) gray += len;
+				}
+				if (sum != width) ok=0;
 			}
-		} else if (strstr(argv[i],"LEVEL=")==argv[i]) {
-			int32_t a,b;
-			if (sscanf(&argv[i][6],"%i,%i",&a,&b) == 2) {
-				LEVEL0=a;
-				LEVEL1=b;
+			// nothing after the last row
+			int32_t extra;
+			ok=ok && (gray > 0) && (fread(&extra,1,1,f) == 0);
+		}
+		if (f) fclose(f);
+		remove(tmp);
+		char note[128];
+		sprintf(note,"%lld gray pixels",(long long)gray);
+		result("EXPORT",ok,note);
+	}
+	
+	// CONTINUE: along the line as without it, at least one
+	// cycle starts from its neighbour
+	{
+		int8_t ok=1;
+		int32_t continued=0;
+		anzcont=0;
+		for(int32_t k=0;k<ANZCONTINUE;k++) {
+			setentry(ckcontinue[k]);
+			batchanalyze(task,buf,0,NULL);
+			int32_t n=0;
+			for(int32_t cp=0;(cp<nbr_of_cp) && (n<3);cp++) {
+				if (cycleselected(cp) > 0) ckcontinue[k].golden[n++]=zero[cp].interiorfound;
 			}
-		} else if (strstr(argv[i],"PERIODS=")==argv[i]) {
-			int32_t a,b;
-			if (sscanf(&argv[i][8],"%i,%i",&a,&b) == 2) {
-				PERIODICLEN0=a;
-				PERIODICLEN1=b;
+			ckcontinue[k].golden[n]=-1;
+		}
+		for(int32_t k=0;k<ANZCONTINUE;k++) {
+			setentry(ckcontinue[k]);
+			_CONTINUE=1;
+			batchanalyze(task,buf,0,NULL);
+			for(int32_t cp=0;cp<nbr_of_cp;cp++) {
+				if ( (cycleselected(cp) > 0) && (zero[cp].continuelevel > 0) ) continued++;
 			}
-		} 
-	} // i
+			if (golden(ckcontinue[k]) <= 0) ok=0;
+			continuationsave();
+		}
+		_CONTINUE=-1;
+		anzcont=0;
+		char note[128];
+		sprintf(note,"%i of %i points continued",continued,ANZCONTINUE);
+		result("CONTINUE",ok && (continued > 0),note);
+	}
 	
-	cplxC=Complex(seedC0re,seedC0im);
-	cplxA=Complex(FAKTORAre,FAKTORAim);
+	// library interface on its own context
+	{
+		TsaContext* c=tsa_create();
+		int8_t ok=1;
+		char line[1024];
+		strcpy(line,cklibrary.params);
+		char* tok=strtok(line," ");
+		while (tok) {
+			if (tsa_set(c,tok) != TSA_OK) ok=0;
+			tok=strtok(NULL," ");
+		}
+		ok=ok && (tsa_set(c,"nonsense=1") == TSA_ERR_PARAM);
+		ok=ok && (tsa_predict(c,-1) == TSA_ERR_STATE);
+		ok=ok && (tsa_find_cycles(c) == TSA_OK);
+		ok=ok && (tsa_predict(c,-5) == TSA_ERR_STATE);
+		ok=ok && (tsa_predict(c,-1) == TSA_OK);
+		int32_t n=tsa_cycle_count(c);
+		for(int32_t i=0;(i<=n) && (ok>0);i++) {
+			TsaCycle y;
+			if (i == n) {
+				ok=(cklibrary.golden[i] < 0);
+			} else if ( (i >= 3) || (tsa_cycle(c,i,&y) != TSA_OK) || (y.analyzed <= 0) || (y.level != cklibrary.golden[i]) ) {
+				ok=0;
+			}
+		}
+		tsa_destroy(c);
+		result("library",ok,"tsa_set, tsa_find_cycles, tsa_predict");
+	}
 	
-	if (LEVEL0<8) LEVEL0=8;
-	if (LEVEL1>31) LEVEL1=31;
+	return failed;
+}
 
-	// setting function pointers
-	setfunc(_FUNC);
-	fkt.output(stdout);
-	fkt.output(flog);
-	fprintf(flog,"ENCW=%i pixels\n",_ENCLOSEMENTWIDTH);
-	if (_STARTWITH == ALL32GRAY) {
-		LOGMSG("  per cycle: analyzing whole rectangle around all periodic points\n");
-	} else {
-		LOGMSG("  per cycle: analyzing small neighbourhoods around periodic point\n");
-	}
+// BENCH=n: the corpus with every bounding-box kernel the CPU has
+// in double and with the scalar one in long double, double-double,
+// float128 and fixed point,
+// each parameter set n times (the fastest counts). The other
+// command-line parameters (THREADS, PROPAGATION, BITMAP, ...) apply
+// to all of them, SIMD and PRECISION are set per run. Reports the
+// cells evaluated per second of level analysis, the fixed-point
+// passes per level and the memory, returns the number of parameter
+// sets whose levels differ from the golden ones
+int32_t runbench(int32_t argc,char** argv) {
+	const int32_t vsimd[]={SIMD_OFF,SIMD_GENERIC,SIMD_AVX2,SIMD_AVX512,SIMD_OFF,SIMD_OFF,SIMD_OFF,SIMD_OFF};
+	const int32_t vprec[]={PRECISION_D,PRECISION_D,PRECISION_D,PRECISION_D,PRECISION_LD,PRECISION_DD,PRECISION_QD,PRECISION_DY};
+	const int32_t anzvariants=sizeof(vsimd)/sizeof(vsimd[0]);
+	const int32_t anzentries=sizeof(benchcorpus)/sizeof(benchcorpus[0]);
 	
-	// must be AFTER setfunc
-	// enclosement for filled-in Julia set is computed
-	COMPLETE1=getLagrange(fkt);
-	COMPLETE0=-COMPLETE1;
-	LOGMSG2("Filled-in set is contained in %.0lg-square\n",(double)COMPLETE1);
-	LOGMSG2("numerical type: %s\n",NNTYPSTR);
+	CmTask task;
+	batchtask(task);
+	TextBuffer buf,out;
+	int32_t mismatches=0;
+	int64_t maxfootprint=0;
+	double* vrate=new double[anzvariants];
 	
-	// searching for zeros
-	ps_find_critical_points();
+	LOGMSG3("benchmark: %i parameter sets, fastest of %i runs (large sets from BENCH=2 on, once)\n",anzentries,_BENCH);
+	LOGMSG("  set func   type kernel  levels      result  seconds  Mcells/s  passes (level/passes)\n");
+	for(int32_t v=0;v<anzvariants;v++) {
+		vrate[v]=-1.0;
+		double vcells=0.0,vseconds=0.0;
+		for(int32_t e=0;e<anzentries;e++) {
+			double best=-1.0,bestlevelseconds=0.0;
+			int64_t cells=0;
+			int8_t ok=1;
+			out.clear();
+			if ( (benchcorpus[e].large > 0) && (_BENCH < 2) ) continue;
+			const int32_t reps=(benchcorpus[e].large > 0 ? 1 : _BENCH);
+			for(int32_t r=0;r<reps;r++) {
+				setdefaults();
+				for(int32_t i=1;i<argc;i++) parseparam(argv[i]);
+				char line[1024];
+				strncpy(line,benchcorpus[e].params,sizeof(line)-1);
+				line[sizeof(line)-1]=0;
+				char* tok=strtok(line," ");
+				while (tok) {
+					parseparam(tok);
+					tok=strtok(NULL," ");
+				}
+				_SIMD=vsimd[v];
+				_PRECISION=vprec[v];
+				setupparams();
+				// instruction set not present
+				if (_SIMD != vsimd[v]) break;
+				
+				task.threads=THREADS;
+				buf.clear();
+				double t0=wallseconds();
+				batchanalyze(task,buf,e+1,NULL);
+				double t=wallseconds()-t0;
+				
+				double levelseconds=0.0;
+				for(int32_t cp=0;cp<nbr_of_cp;cp++) {
+					if (cycleselected(cp) <= 0) continue;
+					for(int32_t i=0;i<zero[cp].anzmetrics;i++) {
+						LevelMetrics& lm=zero[cp].metrics[i];
+						if (lm.source != LEVELSOURCE_COMPUTED) continue;
+						levelseconds += lm.seconds;
+						if (r == 0) cells += lm.cells;
+						if (lm.footprint > maxfootprint) maxfootprint=lm.footprint;
+					}
+				}
+				if ( (best < 0.0) || (t < best) ) {
+					best=t;
+					bestlevelseconds=levelseconds;
+				}
+				if (r > 0) continue;
+				
+				// levels found and passes of the first run
+				char fn[16];
+				recordfuncname(fn);
+				out.append("  %3i %-6s %-4s %-7s",e+1,fn,precisionname[_PRECISION],simdname[_SIMD]);
+				char levels[128];
+				levels[0]=0;
+				int32_t k=0;
+				for(int32_t cp=0;cp<nbr_of_cp;cp++) {
+					if (cycleselected(cp) <= 0) continue;
+					if ( (k >= 3) || (benchcorpus[e].golden[k] != zero[cp].interiorfound) ) ok=0;
+					if (strlen(levels) < 100) sprintf(&levels[strlen(levels)],"%s%i",(k > 0 ? "," : ""),zero[cp].interiorfound);
+					k++;
+				}
+				if ( (k > 3) || (benchcorpus[e].golden[k] >= 0) ) ok=0;
+				out.append(" %-11s %-7s",levels,(ok > 0 ? "ok" : "DIFFERS"));
+			} // r
+			if (best < 0.0) break;
+			
+			out.append(" %8.3lf %9.2lf ",best,(bestlevelseconds > 0.0 ? 1E-6*cells/bestlevelseconds : 0.0));
+			int32_t k=0;
+			for(int32_t cp=0;cp<nbr_of_cp;cp++) {
+				if (cycleselected(cp) <= 0) continue;
+				if ((k++) > 0) out.append(" |");
+				for(int32_t i=0;i<zero[cp].anzmetrics;i++) {
+					LevelMetrics& lm=zero[cp].metrics[i];
+					out.append(" %i/%i",lm.level,lm.passes);
+				}
+			}
+			out.append("\n");
+			LOGMSG2("%s",out.text);
+			if (ok <= 0) mismatches++;
+			vcells += cells;
+			vseconds += bestlevelseconds;
+		} // e
+		if (vseconds > 0.0) vrate[v]=1E-6*vcells/vseconds;
+	} // v
 	
-	if (nbr_of_cp<=0) {
-		LOGMSG("No critical points found.\n");
-		exit(99);
+	LOGMSG("\ncells evaluated per second of level analysis, all sets:\n");
+	for(int32_t v=0;v<anzvariants;v++) {
+		if (vrate[v] < 0.0) {
+			LOGMSG3("  %-4s %-7s not available on this CPU\n",precisionname[vprec[v]],simdname[vsimd[v]]);
+		} else {
+			LOGMSG4("  %-4s %-7s %9.2lf Mcells/s\n",precisionname[vprec[v]],simdname[vsimd[v]],vrate[v]);
+		}
 	}
+	LOGMSG2("largest bitmap %.1lf MB\n",(double)maxfootprint/(1 << 20));
+	#ifdef _FORKAVAILABLE
+	struct rusage ru;
+	if (getrusage(RUSAGE_SELF,&ru) == 0) {
+		// kilobytes on Linux, bytes on macOS
+		#ifdef __APPLE__
+		LOGMSG2("peak memory %.1lf MB (resident)\n",(double)ru.ru_maxrss/(1 << 20));
+		#else
+		LOGMSG2("peak memory %.1lf MB (resident)\n",(double)ru.ru_maxrss/1024);
+		#endif
+	}
+	#endif
+	
+	int32_t statefailed=runbenchstate(argc,argv,task);
+	mismatches += statefailed;
+	if (mismatches > 0) {
+		LOGMSG2("%i parameter sets or modes DIFFER from the golden levels\n",mismatches);
+	} else {
+		LOGMSG("all levels as golden\n");
+	}
+	
+	delete[] vrate;
+	batchtaskfree(task);
 	
+	return mismatches;
+}
+
+// critical points in zero[] as phase 1 found them
+void printcriticalpoints(void) {
 	for(int32_t i=0;i<nbr_of_cp;i++) {
 		LOGMSG("critical point: ");
 		zero[i].attractor.output(stdout);
@@ -1260,13 +6114,10 @@ int32_t main(int32_t argc,char** argv) {
 		LOGMSG("\n");
 	}
 	LOGMSG("\n");
-	
-	// construct orbits of critical points of bounded
-	if (ps_construct_critical_orbits() <= 0) {
-		LOGMSG("No critical orbit found.\n(Does an attractor exist at all?)");
-		exit(99);
-	}
-	
+}
+
+// attracting cycles in zero[] with their periodic points
+void printcycles(void) {
 	// there may be critical points that go into the
 	// same cycle. But only one of them is marked in
 	// the array zero
@@ -1290,81 +6141,557 @@ int32_t main(int32_t argc,char** argv) {
 			LOGMSG(")\n");
 		}
 	}
+}
+
+// library interface, see tsapredictor.h
+
+struct TsaContext {
+	TextBuffer params; // one per line, in the order set
+	// critical points and cycles as tsa_find_cycles left zero[]
+	Root* zeros;
+	int32_t anzzeros;
+	// the cycles selected by PERIODS, indices into zeros
+	int32_t* selected;
+	int8_t* analyzed;
+	int32_t anzselected;
+	int8_t found;
+	char error[512];
+	// the program itself (main): messages of the calls go to the log
+	// and stdout, the cycles found are listed and report is called
+	// per cycle in cycle order before (done=0) and after (done=1)
+	// its analysis
+	int8_t console;
+	void (*report)(const Root&,const CmTask&,const int8_t done,const int8_t joint);
+	double tcritical,torbits; // seconds of the last tsa_find_cycles
+};
+
+// the predictor state is global: one call at a time
+std::mutex librarymutex;
+
+// program modes, not parameters of an analysis
+const char notinlibrary[][16] = {
+	"BATCH=","BATCHOUT=","BATCHFORMAT=","SWEEP=","SWEEPA=","SHARD=","BENCH=","CACHE=","METRICS="
+};
+
+void freeroots(Root* aroots,const int32_t anz) {
+	for(int32_t i=0;i<anz;i++) {
+		if (aroots[i].cycle) delete[] aroots[i].cycle;
+		if (aroots[i].metrics) delete[] aroots[i].metrics;
+		aroots[i].clear();
+	}
+}
+
+// deep copy, without the METRICS counters
+void copyroots(Root* adst,const Root* asrc,const int32_t anz) {
+	for(int32_t i=0;i<anz;i++) {
+		adst[i]=asrc[i];
+		adst[i].metrics=NULL;
+		adst[i].anzmetrics=0;
+		if (!asrc[i].cycle) continue;
+		
+		adst[i].cycle=new PeriodicPoint[asrc[i].cyclelen + 8];
+		for(int32_t k=0;k<asrc[i].cyclelen;k++) adst[i].cycle[k]=asrc[i].cycle[k];
+	}
+}
+
+// the globals as the command line with the parameters of actx
+// would set them
+void loadcontext(TsaContext& actx) {
+	setdefaults();
+	_CHECKPOINTFILE[0]=_RESUMEFILE[0]=0;
+	_EXPORTFILE[0]=0;
+	_CHECKPOINTSECONDS=600;
+	if (actx.params.text) {
+		char* copy=new char[actx.params.len+1];
+		strcpy(copy,actx.params.text);
+		char* tok=strtok(copy,"\n");
+		while (tok) {
+			parseparam(tok);
+			tok=strtok(NULL,"\n");
+		}
+		delete[] copy;
+	}
+	setupparams();
+}
+
+TsaContext* tsa_create(void) {
+	TsaContext* c=new TsaContext;
+	c->zeros=NULL;
+	c->anzzeros=0;
+	c->selected=NULL;
+	c->analyzed=NULL;
+	c->anzselected=0;
+	c->found=0;
+	c->error[0]=0;
+	c->console=0;
+	c->report=NULL;
+	c->tcritical=c->torbits=0.0;
+	
+	return c;
+}
+
+// the cycles of the context are not valid any more
+void tsa_clearcycles(TsaContext* c) {
+	if (c->zeros) {
+		freeroots(c->zeros,c->anzzeros);
+		delete[] c->zeros;
+	}
+	if (c->selected) delete[] c->selected;
+	if (c->analyzed) delete[] c->analyzed;
+	c->zeros=NULL;
+	c->anzzeros=0;
+	c->selected=NULL;
+	c->analyzed=NULL;
+	c->anzselected=0;
+	c->found=0;
+}
+
+void tsa_destroy(TsaContext* c) {
+	if (!c) return;
 	
-	// all zeros with cyclelen>0 => analyze per
-	// cell mapping
-	for(int32_t cp=0;cp<nbr_of_cp;cp++) {
-		if (zero[cp].cyclelen<=0) continue;
+	tsa_clearcycles(c);
+	delete c;
+}
+
+int tsa_set(TsaContext* c,const char* aparam) {
+	if ( (!c) || (!aparam) ) return TSA_ERR_PARAM;
+	
+	std::lock_guard<std::mutex> lock(librarymutex);
+	char arg[1024];
+	strncpy(arg,aparam,sizeof(arg)-1);
+	arg[sizeof(arg)-1]=0;
+	upper(arg);
+	int8_t known=1;
+	for(uint32_t i=0;i<(sizeof(notinlibrary)/sizeof(notinlibrary[0]));i++) {
+		if (strstr(arg,notinlibrary[i]) == arg) known=0;
+	}
+	strncpy(arg,aparam,sizeof(arg)-1);
+	// only checked, the globals are set again from the context
+	// by every call
+	if ( (known <= 0) || (strchr(arg,'\n')) || (parseparam(arg) <= 0) ) {
+		snprintf(c->error,sizeof(c->error),"parameter %s not known",aparam);
+		return TSA_ERR_PARAM;
+	}
+	
+	c->params.append("%s\n",aparam);
+	tsa_clearcycles(c);
+	c->error[0]=0;
+	
+	return TSA_OK;
+}
+
+int tsa_find_cycles(TsaContext* c) {
+	if (!c) return TSA_ERR_STATE;
+	
+	std::lock_guard<std::mutex> lock(librarymutex);
+	tsa_clearcycles(c);
+	c->error[0]=0;
+	librarycall=1;
+	libraryconsole=c->console;
+	int ret=TSA_OK;
+	try {
+		loadcontext(*c);
+		freeroots(zero,MAXZEROS);
+		c->tcritical=wallseconds();
+		ps_find_critical_points();
+		c->tcritical=wallseconds()-c->tcritical;
+		if ( (c->console > 0) && (nbr_of_cp > 0) ) printcriticalpoints();
+		c->torbits=wallseconds();
+		int32_t anzcycles=(nbr_of_cp > 0 ? ps_construct_critical_orbits() : 0);
+		c->torbits=wallseconds()-c->torbits;
+		if (nbr_of_cp <= 0) {
+			strcpy(c->error,"no critical points found");
+			ret=TSA_ERR_NOCRITICAL;
+		} else if (anzcycles <= 0) {
+			strcpy(c->error,"no critical orbit found");
+			ret=TSA_ERR_NOCYCLE;
+		} else {
+			if (c->console > 0) printcycles();
+			c->anzzeros=nbr_of_cp;
+			c->zeros=new Root[nbr_of_cp];
+			copyroots(c->zeros,zero,nbr_of_cp);
+			c->selected=new int32_t[nbr_of_cp];
+			c->analyzed=new int8_t[nbr_of_cp];
+			for(int32_t cp=0;cp<nbr_of_cp;cp++) {
+				if (cycleselected(cp) <= 0) continue;
+				c->selected[c->anzselected]=cp;
+				c->analyzed[c->anzselected]=0;
+				c->anzselected++;
+			}
+			c->found=1;
+		}
+	} catch (TsaFailure&) {
+		strcpy(c->error,lastlogmsg);
+		tsa_clearcycles(c);
+		ret=TSA_ERR_FAILED;
+	}
+	librarycall=libraryconsole=0;
+	
+	return ret;
+}
+
+int tsa_cycle_count(const TsaContext* c) {
+	if ( (!c) || (c->found <= 0) ) return 0;
+	
+	return c->anzselected;
+}
+
+int tsa_cycle(const TsaContext* c,const int i,TsaCycle* erg) {
+	if ( (!c) || (!erg) || (c->found <= 0) || (i < 0) || (i >= c->anzselected) ) return TSA_ERR_STATE;
+	
+	const Root& r=c->zeros[c->selected[i]];
+	erg->cyclenumber=r.cyclenumber;
+	erg->period=r.cyclelen;
+	erg->multiplier=r.multiplier;
+	erg->re=(double)r.cycle[0].pp.re;
+	erg->im=(double)r.cycle[0].pp.im;
+	erg->analyzed=c->analyzed[i];
+	erg->level=r.interiorfound;
+	erg->encw=r.encw;
+	
+	return TSA_OK;
+}
+
+int tsa_predict(TsaContext* c,const int i) {
+	if ( (!c) || (c->found <= 0) || (i < -1) || (i >= c->anzselected) ) return TSA_ERR_STATE;
+	
+	std::lock_guard<std::mutex> lock(librarymutex);
+	c->error[0]=0;
+	librarycall=1;
+	libraryconsole=c->console;
+	int ret=TSA_OK;
+	// the cycles to analyze, indices into selected
+	int32_t anztasks=0;
+	int32_t* taskk=new int32_t[c->anzselected+1];
+	for(int32_t k=0;k<c->anzselected;k++) {
+		if ( (i < 0) || (k == i) ) taskk[anztasks++]=k;
+	}
+	CmTask* tasks=new CmTask[anztasks+1];
+	int8_t* taskdone=new int8_t[anztasks+1];
+	std::thread* cycleth=NULL;
+	int32_t cyclethreads=1;
+	std::mutex donemutex;
+	std::condition_variable donecv;
+	std::atomic<int32_t> nexttask(0);
+	std::exception_ptr failure=NULL;
+	try {
+		loadcontext(*c);
+		// the critical points are needed by SEARCH=PREDICT
+		freeroots(zero,MAXZEROS);
+		copyroots(zero,c->zeros,c->anzzeros);
+		nbr_of_cp=c->anzzeros;
 		
-		if (
-			(PERIODICLEN0>0)
-			&& ( !(
-				(PERIODICLEN0 <= zero[cp].cyclelen) &&
-				(zero[cp].cyclelen <= PERIODICLEN1)
-			) )
-		) {
-			continue;
+		// cycles are independent: with THREADS > 1 they are
+		// analyzed concurrently, every cycle getting its share
+		// of the threads for its sweep. Progress output is buffered
+		// per cycle, so the log comes out in cycle order
+		// JOINT: all of them in one analysis with all threads
+		int8_t joint=( (_JOINT > 0) && (anztasks > 1) );
+		if ( (joint > 0) && (anztasks > MAXJOINT) ) {
+			LOGMSG2("\nJOINT: more than %i cycles, analyzing them separately\n",MAXJOINT);
+			joint=0;
+		}
+		cyclethreads=THREADS;
+		if (joint > 0) cyclethreads=1;
+		if (cyclethreads > anztasks) cyclethreads=anztasks;
+		if (cyclethreads < 1) cyclethreads=1;
+		for(int32_t t=0;t<anztasks;t++) {
+			tasks[t].threads=THREADS / cyclethreads;
+			if (tasks[t].threads < 1) tasks[t].threads=1;
+			if ( (cyclethreads > 1) || (c->console <= 0) ) tasks[t].out=new TextBuffer;
+			taskdone[t]=0;
 		}
 		
-		LOGMSG3("\nanalyzing cycle #%i (period %i) ...\n",zero[cp].cyclenumber,zero[cp].cyclelen);
-			
-		int32_t interiorpresent=cm_local(zero[cp],_STARTWITH);
-		zero[cp].interiorfound=interiorpresent;
-			
-		if (interiorpresent>0) {
-			LOGMSG2("\n  black present at refinement level %i\n",interiorpresent);
-			LOGMSG("  computing this and at latest here emerging cycles from scratch in command-line:\n");
-		    LOGMSG5("    juliatsacore_%s range=%.0lg len=%i %s\n",NNTYPSTR,ceil(COMPLETE1),interiorpresent,COMPUTECOMMANDLINE);
-		    if (interiorpresent > 12) {
-				LOGMSG("  (but level-by-level computation using already calculated data is recommended for speed reasons)\n");
+		// a failing cycle stops handing out cycles, the first
+		// failure is rethrown after all threads joined
+		auto cycleworker=[&](void) {
+			while (1) {
+				int32_t t=nexttask.fetch_add(1);
+				if (t >= anztasks) break;
+				try {
+					cm_local(zero[c->selected[taskk[t]]],_STARTWITH,tasks[t]);
+				} catch (...) {
+					std::lock_guard<std::mutex> lock(donemutex);
+					if (!failure) failure=std::current_exception();
+					nexttask.store(anztasks);
+				}
+				{
+					std::lock_guard<std::mutex> lock(donemutex);
+					taskdone[t]=1;
+				}
+				donecv.notify_all();
+			}
+		};
+		
+		if (cyclethreads > 1) {
+			cycleth=new std::thread[cyclethreads];
+			for(int32_t t=0;t<cyclethreads;t++) {
+				cycleth[t]=std::thread(cycleworker);
 			}
-		} else {
-			LOGMSG3("\n  NO black found in levels %i..%i at current parameters\n",LEVEL0,LEVEL1);
 		}
-	} // cp
-	
-	// do the enclosements of different cycles overlap
-	// if so: detected black for a given cycle might
-	// have actually detected another (earlier emerging) one
-	// only valid if all cycles are actually analyzed (PERIODS command-line)
-	int8_t overlapping=0;
-	for(int32_t i=0;i<nbr_of_cp;i++) {
-		if (
-			(zero[i].cyclelen <= 0) ||
-			(zero[i].interiorfound <= 0) 
-		) continue;
 		
-		for(int32_t k=0;k<nbr_of_cp;k++) {
-			if (
-				(i==k) ||
-				(zero[k].cyclelen <= 0) ||
-				(zero[k].interiorfound <= 0) 
-			) continue;
-			
-			// does enclosement i overlap with k
-			if (
-				(zero[i].ps_basinrect.x1 < zero[k].ps_basinrect.x0) ||
-				(zero[i].ps_basinrect.x0 > zero[k].ps_basinrect.x1) ||
-				(zero[i].ps_basinrect.y1 < zero[k].ps_basinrect.y0) ||
-				(zero[i].ps_basinrect.y0 > zero[k].ps_basinrect.y1)
-			) {
-			} else {
-				overlapping=1;
-				break;
+		if (joint > 0) {
+			Root* jointcycles[MAXJOINT];
+			LOGMSG("\nanalyzing cycles");
+			for(int32_t t=0;t<anztasks;t++) {
+				jointcycles[t]=&zero[c->selected[taskk[t]]];
+				LOGMSG2(" #%i",jointcycles[t]->cyclenumber);
+			}
+			LOGMSG(" jointly ...\n");
+			cm_joint(jointcycles,anztasks,_STARTWITH,tasks[0]);
+			LOGMSG("\n");
+		}
+		
+		for(int32_t t=0;t<anztasks;t++) {
+			int32_t k=taskk[t];
+			int32_t cp=c->selected[k];
+			if (c->report) c->report(zero[cp],tasks[t],0,joint);
+			if (cyclethreads > 1) {
+				std::unique_lock<std::mutex> lock(donemutex);
+				donecv.wait(lock,[&]{ return ( (taskdone[t]>0) || (failure) ); });
+				if (failure) break;
+			} else if (joint <= 0) {
+				cm_local(zero[cp],_STARTWITH,tasks[t]);
+			}
+			c->zeros[cp].interiorfound=zero[cp].interiorfound;
+			c->zeros[cp].ps_basinrect=zero[cp].ps_basinrect;
+			c->zeros[cp].encw=zero[cp].encw*(_STARTWITH == ALL32GRAY ? -1 : 1);
+			c->analyzed[k]=1;
+			if (c->report) c->report(zero[cp],tasks[t],1,joint);
+		} // t
+		
+		if (cycleth) {
+			for(int32_t t=0;t<cyclethreads;t++) {
+				cycleth[t].join();
 			}
-		} // x
-		if (overlapping>0) break;
+			delete[] cycleth;
+			cycleth=NULL;
+		}
+		if (failure) std::rethrow_exception(failure);
+	} catch (TsaFailure&) {
+		strcpy(c->error,lastlogmsg);
+		ret=TSA_ERR_FAILED;
+	}
+	for(int32_t t=0;t<anztasks;t++) {
+		if (tasks[t].out) delete tasks[t].out;
+	}
+	delete[] tasks;
+	delete[] taskdone;
+	delete[] taskk;
+	librarycall=libraryconsole=0;
+	
+	return ret;
+}
+
+const char* tsa_error(const TsaContext* c) {
+	if (!c) return "";
+	
+	return c->error;
+}
+
+#ifndef TSA_LIBRARY
+// progress and result of a cycle of the single analysis
+void reportcycle(const Root& acycle,const CmTask& atask,const int8_t adone,const int8_t ajoint) {
+	if (adone <= 0) {
+		LOGMSG3("\nanalyzing cycle #%i (period %i) ...\n",acycle.cyclenumber,acycle.cyclelen);
+		return;
+	}
+	
+	// analyzed concurrently: buffered
+	if ( (atask.out) && (atask.out->text) ) printf("%s",atask.out->text);
+	int32_t interiorpresent=acycle.interiorfound;
+	if (interiorpresent>0) {
+		LOGMSG2("\n  black present at refinement level %i\n",interiorpresent);
+		if (_ENCWAUTO > 0) LOGMSG2("  (ENCW=%i)\n",acycle.encw*(_STARTWITH == ALL32GRAY ? -1 : 1));
+		LOGMSG("  computing this and at latest here emerging cycles from scratch in command-line:\n");
+		// juliatsacore has no fixed-point or double-double binary
+		int coreprec=levelprecision(interiorpresent);
+		if (coreprec >= PRECISION_DY) coreprec=PRECISION_QD;
+	    LOGMSG5("    juliatsacore_%s range=%.0lg len=%i %s\n",precisionname[coreprec],ceil(COMPLETE1),interiorpresent,COMPUTECOMMANDLINE);
+	    if (interiorpresent > 12) {
+			LOGMSG("  (but level-by-level computation using already calculated data is recommended for speed reasons)\n");
+		}
+		if (atask.exportlevel > 0) {
+			LOGMSG2("  bitmap of this level written to %s\n",atask.exportfn);
+		} else if ( (_EXPORTFILE[0]) && (ajoint <= 0) ) {
+			LOGMSG("  bitmap not written, the level is from the cache or a checkpoint\n");
+		}
+	} else {
+		LOGMSG3("\n  NO black found in levels %i..%i at current parameters\n",LEVEL0,LEVEL1);
+	}
+}
+
+int32_t main(int32_t argc,char** argv) {
+	double c0=wallseconds();
+	
+	flog=fopen("tsapredictor.log","at");
+	fprintf(flog,"\n-----------------\n");
+	
+	// the single analysis is a call of the library interface with
+	// output. Its context gets the command line before parseparam
+	// changes its case, program modes (CACHE, METRICS) are set
+	// below, parameters not known are ignored as before
+	TsaContext* ctx=tsa_create();
+	ctx->console=1;
+	ctx->report=reportcycle;
+	for(int32_t i=1;i<argc;i++) tsa_set(ctx,argv[i]);
+	
+	setdefaults();
+	for(int32_t i=1;i<argc;i++) {
+		parseparam(argv[i]);
+	} // i
+	
+	if (_CACHEFILE[0]) {
+		rcache.open(_CACHEFILE);
+		fprintf(flog,"cache %s: %lld level results\n",_CACHEFILE,(long long)rcache.anz);
+	}
+	if (_METRICSFILE[0]) {
+		metricsfile=fopen(_METRICSFILE,"at");
+		if (!metricsfile) {
+			LOGMSG2("Error. Metrics file %s not writeable.\n",_METRICSFILE);
+			fail();
+		}
+		setvbuf(metricsfile,NULL,_IONBF,0);
+	}
+	
+	if (_BENCH > 0) {
+		tsa_destroy(ctx);
+		int32_t mismatches=runbench(argc,argv);
+		if (metricsfile) fclose(metricsfile);
+		fprintf(flog,"%.0lf sec duration\n",wallseconds()-c0);
+		return (mismatches > 0 ? 1 : 0);
+	}
+	
+	int8_t sweep=( 
+		( (_SWEEPC.nre > 0) && (_SWEEPC.nim > 0) ) ||
+		( (_SWEEPA.nre > 0) && (_SWEEPA.nim > 0) )
+	);
+	if ( (sweep > 0) || (_BATCHFILE[0]) ) {
+		tsa_destroy(ctx);
+		if (sweep > 0) runsweep(argc,argv);
+		else runbatch(argc,argv);
+		if (metricsfile) fclose(metricsfile);
+		fprintf(flog,"%.0lf sec duration\n",wallseconds()-c0);
+		return 0;
+	}
+	
+	printf("  FUNC=string / c=re,im / A=re,im / ENCW=n|auto[,n] / LEVEL=n,m / PERIODS=n,m\n");
+	printf("  PROPAGATION=sweep|worklist / THREADS=n / INCREMENTAL=0|1 / MIXED=0|1 / JOINT=0|1 / SEARCH=linear|gallop|predict\n");
+	printf("  CRITICAL=auto|aberth|scan\n");
+	printf("  SIMD=auto|off|generic|avx2|avx512 / PRECISION=d|ld|dd|qd|auto|dy / BITMAP=rows|tiles\n");
+	printf("  MEMLIMIT=MB / BATCH=file / BATCHOUT=file / BATCHFORMAT=csv|jsonl\n");
+	printf("  SWEEP=re0,re1,im0,im1,n,m / SWEEPA=re0,re1,im0,im1,n,m / SHARD=i/n / CONTINUE=margin\n");
+	printf("  CACHE=file / CHECKPOINT=file,seconds / RESUME=file / EXPORT=file / METRICS=file / BENCH=n\n");
+	
+	// adjustments setupparams makes silently
+	int8_t tilessweep=(
+		(_BITMAP==BITMAP_TILES) &&
+		( (_PROPAGATION==PROPAGATION_WORKLIST) || (_INCREMENTAL>0) )
+	);
+	int8_t memlimitasked=(_MEMLIMIT > 0);
+	setupparams();
+	fkt.output(stdout);
+	fkt.output(flog);
+	if (_ENCWAUTO > 0) fprintf(flog,"ENCW=auto %i..%i pixels\n",ENCWAUTOMIN,_ENCLOSEMENTWIDTH);
+	else fprintf(flog,"ENCW=%i pixels\n",_ENCLOSEMENTWIDTH);
+	if (_STARTWITH == ALL32GRAY) {
+		LOGMSG("  per cycle: analyzing whole rectangle around all periodic points\n");
+	} else {
+		LOGMSG("  per cycle: analyzing small neighbourhoods around periodic point\n");
+	}
+	if (_ENCWAUTO > 0) {
+		LOGMSG3("  enclosement width per level doubled from %i up to %i until black emerges\n",ENCWAUTOMIN,_ENCLOSEMENTWIDTH);
+	}
+	if (_BITMAP==BITMAP_TILES) {
+		LOGMSG("  bitmap in 64x64 tiles around the periodic points\n");
+		if (tilessweep>0) {
+			LOGMSG("  (tiles: plain sweep, no worklist, not incremental)\n");
+		}
+	}
+	if (_MEMLIMIT > 0) {
+		LOGMSG2("  bitmaps above %.0lf MB in RAM file-backed in the current directory\n",(double)(_MEMLIMIT >> 20));
+	} else if (memlimitasked > 0) {
+		LOGMSG("  MEMLIMIT: file-backed memory not available on this system\n");
+	}
+	if (_PROPAGATION==PROPAGATION_WORKLIST) {
+		LOGMSG("  propagation via worklist\n");
+	}
+	if (THREADS > 1) {
+		LOGMSG2("  %i threads\n",THREADS);
+	}
+	if ( (_INCREMENTAL>0) && (_PROPAGATION==PROPAGATION_SWEEP) ) {
+		LOGMSG("  sweep order taken from previous level\n");
+	}
+	if (_MIXED > 0) {
+		LOGMSG("  bounding boxes first in double, in the level's type only near an edge\n");
+	}
+	if (_JOINT > 0) {
+		LOGMSG("  cycles analyzed jointly, one bitmap plane per cycle\n");
+	}
+	if (_SEARCH==SEARCH_GALLOP) {
+		LOGMSG("  level search: gallop and bisection\n");
+	} else if (_SEARCH==SEARCH_PREDICT) {
+		LOGMSG("  level search: starting at the level predicted from the multiplier\n");
+	}
+	if (_CRITICAL==CRITICAL_ABERTH) {
+		LOGMSG("  critical points: Aberth iteration\n");
+	} else if (_CRITICAL==CRITICAL_SCAN) {
+		LOGMSG("  critical points: Newton from the border\n");
+	}
+	if (_SIMD != SIMD_OFF) {
+		LOGMSG2("  bounding boxes in batches: %s\n",simdname[_SIMD]);
 	}
+	if (_CACHEFILE[0]) {
+		LOGMSG3("  level results cached in %s (%lld known)\n",_CACHEFILE,(long long)rcache.anz);
+	}
+	if (_EXPORTFILE[0]) {
+		LOGMSG2("  bitmap of the level black emerges at written to %s.c<cycle number>\n",_EXPORTFILE);
+	}
+	
+	LOGMSG2("Filled-in set is contained in %.0lg-square\n",(double)COMPLETE1);
+	LOGMSG2("numerical type: %s\n",NNTYPSTR);
+	if (_PRECISION == PRECISION_AUTO) {
+		LOGMSG("levels analyzed in: per level by function (PRECISION=auto)\n");
+	} else if (_PRECISION == PRECISION_DY) {
+		LOGMSG2("levels analyzed in: exact fixed point of 128, 192 or 256 bits per level, %i integer bits (PRECISION=dy)\n",dyadicintbits);
+	} else {
+		LOGMSG2("levels analyzed in: %s\n",precisionname[_PRECISION]);
+	}
+	
+	// phase 1 and 2 through the library interface, zero[] is left
+	// as the last call set it
+	int ret=tsa_find_cycles(ctx);
+	if (ret == TSA_ERR_NOCRITICAL) {
+		LOGMSG("No critical points found.\n");
+	} else if (ret == TSA_ERR_NOCYCLE) {
+		LOGMSG("No critical orbit found.\n(Does an attractor exist at all?)");
+	}
+	if (ret == TSA_OK) ret=tsa_predict(ctx,-1);
+	if (ret != TSA_OK) {
+		tsa_destroy(ctx);
+		fail();
+	}
+	int8_t joint=( (_JOINT > 0) && (tsa_cycle_count(ctx) > 1) && (tsa_cycle_count(ctx) <= MAXJOINT) );
 	
-	if (overlapping>0) {
+	int8_t overlapping=cyclesoverlap();
+	
+	if ( (overlapping>0) && (joint>0) ) {
+		LOGMSG("\n\nEnclosements of periodic points of different cycles overlap.\n");
+		LOGMSG("  Analyzed jointly: black is counted only for a cycle with a periodic point in it.\n");
+	} else if (overlapping>0) {
 		LOGMSG("\n\n!!!!! CAVE !!!!!\n  Enclosements of periodic points of different cycles overlap.\n");
 		LOGMSG("  Black when detected for a specific cycle might have actually detected a different one.\n");
 	}
 	
-	int32_t c1=clock();
-	LOGMSG2("%.0lf sec duration\n",
-		(double)(c1-c0)/CLOCKS_PER_SEC);
+	if (metricsfile) {
+		metricsrecord(0,NULL,ctx->tcritical,ctx->torbits,wallseconds()-c0);
+		fclose(metricsfile);
+	}
+	tsa_destroy(ctx);
+	
+	LOGMSG2("%.0lf sec duration\n",wallseconds()-c0);
 		
     return 0;
 }
+#endif
 
@@ -0,0 +1,73 @@
+// TSApredictor as a library: compile main.cpp with -DTSA_LIBRARY
+// (no main function) and link it to the program.
+//
+// A serialized C wrapper around the program, not a reentrant
+// predictor. A context holds the parameters and the cycles found
+// for them, calls on different contexts may come from different
+// threads. But the predictor keeps all its state in process
+// globals (cycles, function, number types, parameters, error
+// message), so one mutex lets only one call run at a time: every
+// call sets the globals from its context, analyzes and copies the
+// results back into the context. THREADS=n still parallelizes
+// within a call (several cycles concurrently, as the program does).
+//
+// Functions return TSA_OK or an error code and do not end the program,
+// also not for errors within the worker threads of THREADS > 1.
+// No output is written to stdout, tsapredictor.log is not written.
+
+#ifndef TSAPREDICTOR_H
+#define TSAPREDICTOR_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum {
+	TSA_OK=0,
+	TSA_ERR_PARAM=1, // unknown parameter
+	TSA_ERR_STATE=2, // tsa_find_cycles not called, or cycle index out of range
+	TSA_ERR_NOCRITICAL=3, // no critical points found
+	TSA_ERR_NOCYCLE=4, // no critical orbit ends in an attracting cycle
+	TSA_ERR_FAILED=5 // error in the analysis (memory, file), see tsa_error
+};
+
+typedef struct TsaContext TsaContext;
+
+// an attracting cycle found by tsa_find_cycles
+typedef struct TsaCycle {
+	int cyclenumber;
+	int period;
+	double multiplier; // |(f^period)'| along the cycle
+	double re,im; // first periodic point
+	int analyzed; // tsa_predict was called for it
+	int level; // refinement level black emerges at, 0 = none in LEVEL
+	int encw; // enclosement width of that level
+} TsaCycle;
+
+TsaContext* tsa_create(void);
+void tsa_destroy(TsaContext*);
+
+// one parameter as on the command line, e.g. "func=z3azc", "c=0.1,0.2",
+// "level=10,14", "encw=auto". Parameters apply in the order given.
+// The modes of the program (BATCH, SWEEP, BENCH, CACHE, METRICS)
+// are not available
+int tsa_set(TsaContext*,const char*);
+
+// phase 1: critical points, their orbits and the attracting cycles
+// selected by PERIODS
+int tsa_find_cycles(TsaContext*);
+int tsa_cycle_count(const TsaContext*);
+int tsa_cycle(const TsaContext*,const int,TsaCycle*);
+
+// phase 2: the level black emerges at for cycle i (-1 = all cycles,
+// any other index outside the cycles is TSA_ERR_STATE)
+int tsa_predict(TsaContext*,const int);
+
+// message of the last error of the context, "" if none
+const char* tsa_error(const TsaContext*);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif